@@ -0,0 +1,195 @@
+#include "NavAsyncPathService.h"
+#include "NavPathfinder.h"
+#include "Misc/ScopeLock.h"
+
+FNavAsyncPathService::FNavAsyncPathService()
+	: Shared(MakeShared<FShared, ESPMode::ThreadSafe>())
+{
+}
+
+FNavAsyncPathService::~FNavAsyncPathService()
+{
+	Shutdown();
+}
+
+int32 FNavAsyncPathService::AddRequest(const FVector& InStart, const FVector& InDestination, const FNavPathQuery& Options, EPathRequestPriority Priority, int32 IgnoredObstacleSlot)
+{
+	const int32 RequestId = NextRequestId++;
+
+	FRequestPtr Request = MakeShared<FRequest, ESPMode::ThreadSafe>();
+	Request->RequestId = RequestId;
+	Request->Start = InStart;
+	Request->Destination = InDestination;
+	Request->Options = Options;
+	Request->IgnoredObstacleSlot = IgnoredObstacleSlot;
+
+	// Ids only need to be unique among outstanding requests; skip INDEX_NONE and 0 on wrap-around
+	if (NextRequestId <= 0)
+	{
+		NextRequestId = 1;
+	}
+
+	Outstanding.Add(RequestId, Request);
+	Queued[static_cast<int32>(Priority)].PushLast(MoveTemp(Request));
+	return RequestId;
+}
+
+bool FNavAsyncPathService::CancelRequest(int32 RequestId)
+{
+	FRequestPtr Request;
+	if (!Outstanding.RemoveAndCopyValue(RequestId, Request))
+	{
+		return false;
+	}
+
+	// Queued requests are skipped by Dispatch; running ones stop at the next poll
+	Request->bCancelled.store(true, std::memory_order_relaxed);
+	return true;
+}
+
+void FNavAsyncPathService::Dispatch(const FNavGridSnapshotPtr& Snapshot, const FNavOccupancySnapshotPtr& Occupancy, int32 MaxConcurrentSearches)
+{
+	if (!Snapshot.IsValid() || !Snapshot->IsInitialized())
+	{
+		return;
+	}
+
+	RunningTasks.RemoveAllSwap([](const UE::Tasks::FTask& Task) { return Task.IsCompleted(); });
+
+	// Highest priority queue first
+	for (int32 PriorityIndex = UE_ARRAY_COUNT(Queued) - 1; PriorityIndex >= 0; --PriorityIndex)
+	{
+		TDeque<FRequestPtr>& Queue = Queued[PriorityIndex];
+		while (!Queue.IsEmpty() && RunningTasks.Num() < MaxConcurrentSearches)
+		{
+			FRequestPtr Request = MoveTemp(Queue.First());
+			Queue.PopFirst();
+
+			if (Request->bCancelled.load(std::memory_order_relaxed))
+			{
+				continue;
+			}
+
+			RunningTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION,
+				[Snapshot, Occupancy, Request, SharedState = Shared]()
+				{
+					RunRequest(*Snapshot, Occupancy.Get(), *Request, *SharedState);
+				}));
+		}
+	}
+}
+
+bool FNavAsyncPathService::PopResult(FNavAsyncPathResult& OutResult)
+{
+	while (Shared->Results.Dequeue(OutResult))
+	{
+		// Results of cancelled requests are no longer outstanding: drop them
+		if (Outstanding.Remove(OutResult.RequestId) > 0)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+void FNavAsyncPathService::Shutdown()
+{
+	for (const TPair<int32, FRequestPtr>& Pair : Outstanding)
+	{
+		Pair.Value->bCancelled.store(true, std::memory_order_relaxed);
+	}
+	Outstanding.Empty();
+
+	for (TDeque<FRequestPtr>& Queue : Queued)
+	{
+		Queue.Reset();
+	}
+
+	UE::Tasks::Wait(RunningTasks);
+	RunningTasks.Empty();
+
+	// Drop results nobody will pick up
+	FNavAsyncPathResult Discarded;
+	while (Shared->Results.Dequeue(Discarded))
+	{
+	}
+}
+
+void FNavAsyncPathService::RunRequest(const FNavGrid& Grid, const FNavOccupancyLayer* Occupancy, const FRequest& Request, FShared& SharedState)
+{
+	if (Request.bCancelled.load(std::memory_order_relaxed))
+	{
+		return;
+	}
+
+	FNavAsyncPathResult Result;
+	Result.RequestId = Request.RequestId;
+
+	// Convert world-space start/destination to grid cells
+	const int32 StartNode = Grid.GetIndex(Grid.GetClampedCoordinates(Request.Start));
+	int32 GoalNode = Grid.GetIndex(Grid.GetClampedCoordinates(Request.Destination));
+
+	// Dynamic obstacles (other than the agent itself) are avoided through the shared layer
+	const bool bUseOccupancy = Occupancy && Occupancy->HasOccupiedCells();
+	auto IsCellFree = [Occupancy, &Request](int32 Cell)
+		{
+			return !Occupancy->IsOccupiedAround(Cell, Request.Options.RequiredClearance, Request.IgnoredObstacleSlot);
+		};
+
+	// Snap goal to nearest free node if the agent does not fit there
+	const int32 RequiredClearance = Request.Options.RequiredClearance;
+	if (!Grid.IsPassable(GoalNode, RequiredClearance) || (bUseOccupancy && !IsCellFree(GoalNode)))
+	{
+		GoalNode = bUseOccupancy
+			? FNavPathfinder::FindNearestFreeNode(Grid, GoalNode, RequiredClearance, IsCellFree, Request.Options.GoalSearchRadius)
+			: FNavPathfinder::FindNearestFreeNode(Grid, GoalNode, RequiredClearance, FNavPathfinder::FAcceptAllCells(), Request.Options.GoalSearchRadius);
+	}
+
+	if (GoalNode != INDEX_NONE)
+	{
+		TUniquePtr<FNavSearchContext> Context = SharedState.AcquireContext();
+
+		FNavPathQuery Query = Request.Options;
+		Query.StartNode = StartNode;
+		Query.GoalNode = GoalNode;
+		Query.CancelFlag = &Request.bCancelled;
+
+		// Cell filters rule out jump point search, so occupied layers fall back to plain A*
+		Result.bSuccess = bUseOccupancy
+			? FNavPathfinder::FindPath(Grid, *Context, Query, IsCellFree)
+			: FNavPathfinder::FindPath(Grid, *Context, Query);
+		Result.NumExpanded = Context->NumExpanded;
+
+		if (Result.bSuccess)
+		{
+			Result.Path.Reserve(Context->PathNodes.Num());
+			for (const int32 Node : Context->PathNodes)
+			{
+				Result.Path.Add(Grid.GetCellCenter(Node));
+			}
+		}
+
+		SharedState.ReleaseContext(MoveTemp(Context));
+	}
+
+	if (!Request.bCancelled.load(std::memory_order_relaxed))
+	{
+		SharedState.Results.Enqueue(MoveTemp(Result));
+	}
+}
+
+TUniquePtr<FNavSearchContext> FNavAsyncPathService::FShared::AcquireContext()
+{
+	FScopeLock Lock(&FreeContextsLock);
+	if (FreeContexts.Num() > 0)
+	{
+		return FreeContexts.Pop(EAllowShrinking::No);
+	}
+	return MakeUnique<FNavSearchContext>();
+}
+
+void FNavAsyncPathService::FShared::ReleaseContext(TUniquePtr<FNavSearchContext> Context)
+{
+	FScopeLock Lock(&FreeContextsLock);
+	FreeContexts.Add(MoveTemp(Context));
+}
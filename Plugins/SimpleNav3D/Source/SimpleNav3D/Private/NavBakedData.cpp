@@ -0,0 +1,93 @@
+#include "NavBakedData.h"
+#include "Serialization/CustomVersion.h"
+
+const FGuid FNavBakedDataVersion::GUID(0x5A3D7C21, 0x4E8B4F10, 0x9C6A2B73, 0xD1E04F86);
+
+static FCustomVersionRegistration GRegisterNavBakedDataVersion(FNavBakedDataVersion::GUID, FNavBakedDataVersion::LatestVersion, TEXT("SimpleNav3DBakedDataVer"));
+
+void UNavBakedData::Serialize(FArchive& Ar)
+{
+	Super::Serialize(Ar);
+	Ar.UsingCustomVersion(FNavBakedDataVersion::GUID);
+
+	if (Ar.IsLoading())
+	{
+		// Volumes still using the previous grid keep their reference
+		ResetData();
+	}
+
+	Ar << bHasData;
+	if (!bHasData)
+	{
+		return;
+	}
+
+	Ar << Settings;
+	Grid->Serialize(Ar);
+	Octree.Serialize(Ar);
+	Ar << bHasSparseVoxelGraph;
+	if (bHasSparseVoxelGraph)
+	{
+		SparseVoxelGraph.Serialize(Ar);
+	}
+	if (Ar.CustomVer(FNavBakedDataVersion::GUID) >= FNavBakedDataVersion::ComponentLabels)
+	{
+		Ar << bHasComponentLabels;
+		if (bHasComponentLabels)
+		{
+			ComponentLabels.Serialize(Ar);
+		}
+	}
+
+	if (Ar.IsLoading())
+	{
+		// The graph indexes octree nodes, so it must come from this exact octree
+		const bool bValid = !Ar.IsError()
+			&& Grid->GetSize() == Settings.GridSize
+			&& (!bHasSparseVoxelGraph || SparseVoxelGraph.IsBuiltFor(Octree))
+			&& (!bHasComponentLabels || ComponentLabels.GetNumCells() == Grid->GetNumCells());
+		if (!bValid)
+		{
+#if WITH_EDITOR
+			UE_LOG(LogTemp, Warning, TEXT("NavBakedData: %s holds invalid navigation data; bake it again."), *GetPathName());
+#endif
+			ResetData();
+		}
+	}
+}
+
+void UNavBakedData::ResetData()
+{
+	bHasData = false;
+	Settings = FNavBakeSettings();
+	Grid = MakeShared<FNavGrid, ESPMode::ThreadSafe>();
+	Octree.Reset();
+	bHasSparseVoxelGraph = false;
+	SparseVoxelGraph.Reset();
+	bHasComponentLabels = false;
+	ComponentLabels.Reset();
+}
+
+#if WITH_EDITOR
+void UNavBakedData::Store(const FNavBakeSettings& InSettings, const FNavGrid& InGrid, const FNavOctree& InOctree, const FNavSparseVoxelGraph* InSparseVoxelGraph, const FNavComponentLabels* InComponentLabels)
+{
+	ResetData();
+
+	bHasData = true;
+	Settings = InSettings;
+	Grid = MakeShared<FNavGrid, ESPMode::ThreadSafe>(InGrid);
+	Octree = InOctree;
+	bHasSparseVoxelGraph = InSparseVoxelGraph != nullptr;
+	if (InSparseVoxelGraph)
+	{
+		SparseVoxelGraph = *InSparseVoxelGraph;
+	}
+	bHasComponentLabels = InComponentLabels != nullptr;
+	if (InComponentLabels)
+	{
+		ComponentLabels = *InComponentLabels;
+	}
+
+	MarkPackageDirty();
+}
+#endif
@@ -0,0 +1,100 @@
+#include "NavBatchPathService.h"
+#include "NavGrid.h"
+#include "NavOccupancyLayer.h"
+#include "Async/ParallelFor.h"
+#include "Async/TaskGraphInterfaces.h"
+#include <atomic>
+
+int32 FNavBatchPathService::Run(const FNavGrid& Grid, const FNavOccupancyLayer* Occupancy, TConstArrayView<FNavBatchPathRequest> Requests, TArray<FNavBatchPathResult>& OutResults, bool bParallel)
+{
+	OutResults.Reset();
+	OutResults.SetNum(Requests.Num());
+	if (Requests.Num() == 0)
+	{
+		return 0;
+	}
+
+	// One worker per core at most (the calling thread takes part), never more than there are queries
+	const int32 NumWorkers = bParallel
+		? FMath::Min(Requests.Num(), FTaskGraphInterface::Get().GetNumWorkerThreads() + 1)
+		: 1;
+	while (Contexts.Num() < NumWorkers)
+	{
+		Contexts.Add(MakeUnique<FNavSearchContext>());
+	}
+
+	// Each worker keeps claiming the next unclaimed query until none are left
+	std::atomic<int32> NextRequest = 0;
+	std::atomic<int32> NumSucceeded = 0;
+	ParallelFor(NumWorkers, [this, &Grid, Occupancy, Requests, &OutResults, &NextRequest, &NumSucceeded](int32 WorkerIndex)
+		{
+			FNavSearchContext& Context = *Contexts[WorkerIndex];
+			for (int32 RequestIndex = NextRequest.fetch_add(1, std::memory_order_relaxed);
+				RequestIndex < Requests.Num();
+				RequestIndex = NextRequest.fetch_add(1, std::memory_order_relaxed))
+			{
+				FNavBatchPathResult& Result = OutResults[RequestIndex];
+				RunRequest(Grid, Occupancy, Requests[RequestIndex], Context, Result);
+				if (Result.Status == ENavBatchPathStatus::ENBPS_Succeeded)
+				{
+					NumSucceeded.fetch_add(1, std::memory_order_relaxed);
+				}
+			}
+		},
+		NumWorkers > 1 ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+
+	return NumSucceeded.load(std::memory_order_relaxed);
+}
+
+void FNavBatchPathService::Reset()
+{
+	Contexts.Empty();
+}
+
+void FNavBatchPathService::RunRequest(const FNavGrid& Grid, const FNavOccupancyLayer* Occupancy, const FNavBatchPathRequest& Request, FNavSearchContext& Context, FNavBatchPathResult& OutResult)
+{
+	// Convert world-space start/destination to grid cells
+	const int32 StartNode = Grid.GetIndex(Grid.GetClampedCoordinates(Request.Start));
+	int32 GoalNode = Grid.GetIndex(Grid.GetClampedCoordinates(Request.Destination));
+
+	// Dynamic obstacles (other than the agent itself) are avoided through the shared layer
+	const bool bUseOccupancy = Occupancy && Occupancy->HasOccupiedCells();
+	auto IsCellFree = [Occupancy, &Request](int32 Cell)
+		{
+			return !Occupancy->IsOccupiedAround(Cell, Request.Options.RequiredClearance, Request.IgnoredObstacleSlot);
+		};
+
+	// Snap goal to nearest free node if the agent does not fit there
+	const int32 RequiredClearance = Request.Options.RequiredClearance;
+	if (!Grid.IsPassable(GoalNode, RequiredClearance) || (bUseOccupancy && !IsCellFree(GoalNode)))
+	{
+		GoalNode = bUseOccupancy
+			? FNavPathfinder::FindNearestFreeNode(Grid, GoalNode, RequiredClearance, IsCellFree, Request.Options.GoalSearchRadius)
+			: FNavPathfinder::FindNearestFreeNode(Grid, GoalNode, RequiredClearance, FNavPathfinder::FAcceptAllCells(), Request.Options.GoalSearchRadius);
+	}
+
+	if (GoalNode == INDEX_NONE)
+	{
+		OutResult.Status = ENavBatchPathStatus::ENBPS_NoFreeGoal;
+		return;
+	}
+
+	FNavPathQuery Query = Request.Options;
+	Query.StartNode = StartNode;
+	Query.GoalNode = GoalNode;
+
+	const bool bFound = bUseOccupancy
+		? FNavPathfinder::FindPath(Grid, Context, Query, IsCellFree)
+		: FNavPathfinder::FindPath(Grid, Context, Query);
+	OutResult.Status = bFound ? ENavBatchPathStatus::ENBPS_Succeeded : ENavBatchPathStatus::ENBPS_NoPath;
+	OutResult.NumExpanded = Context.NumExpanded;
+
+	if (bFound)
+	{
+		OutResult.Path.Reserve(Context.PathNodes.Num());
+		for (const int32 Node : Context.PathNodes)
+		{
+			OutResult.Path.Add(Grid.GetCellCenter(Node));
+		}
+	}
+}
@@ -0,0 +1,763 @@
+#include "NavClusterGraph.h"
+#include "NavPathfinder.h"
+#include "Algo/BinarySearch.h"
+#include "Algo/Unique.h"
+
+namespace NavClusterGraph
+{
+	/**
+	 * The grid restricted to a box of clusters, as an A* graph.
+	 * Without a goal the heuristic is zero, which turns FindGraphPath into Dijkstra.
+	 */
+	struct FClusterSearchGraph
+	{
+		FClusterSearchGraph(const FNavGrid& InGrid, int32 InRequiredClearance, const FIntVector& InMin, const FIntVector& InMax, int32 InGoalCell = INDEX_NONE)
+			: Grid(InGrid)
+			, RequiredClearance(InRequiredClearance)
+			, Min(InMin)
+			, Max(InMax)
+			, bHasGoal(InGoalCell != INDEX_NONE)
+			, GoalCoordinates(bHasGoal ? FVector(InGrid.GetCoordinates(InGoalCell)) : FVector::ZeroVector)
+		{
+		}
+
+		FORCEINLINE int32 GetNumNodes() const { return Grid.GetNumCells(); }
+
+		FORCEINLINE FIntVector GetPagedSize() const { return Grid.GetSearchPagedSize(); }
+
+		FORCEINLINE float GetHeuristic(int32 Node) const
+		{
+			return bHasGoal ? FVector::Distance(FVector(Grid.GetCoordinates(Node)), GoalCoordinates) : 0.0f;
+		}
+
+		template <typename FuncType>
+		FORCEINLINE void ForEachNeighbour(int32 Node, FuncType&& Func) const
+		{
+			Grid.ForEachNeighbour(Node, [this, &Func](int32 Neighbour, float EdgeCost)
+				{
+					const FIntVector Coordinates = Grid.GetCoordinates(Neighbour);
+					if (Coordinates.X >= Min.X && Coordinates.X <= Max.X
+						&& Coordinates.Y >= Min.Y && Coordinates.Y <= Max.Y
+						&& Coordinates.Z >= Min.Z && Coordinates.Z <= Max.Z
+						&& Grid.IsPassable(Neighbour, RequiredClearance))
+					{
+						Func(Neighbour, EdgeCost);
+					}
+				});
+		}
+
+		const FNavGrid& Grid;
+		int32 RequiredClearance;
+		FIntVector Min;
+		FIntVector Max;
+		bool bHasGoal;
+		FVector GoalCoordinates;
+	};
+
+	/** Union-find root lookup with path halving. */
+	static int32 FindRoot(TArray<int32>& Parents, int32 Slot)
+	{
+		while (Parents[Slot] != Slot)
+		{
+			Parents[Slot] = Parents[Parents[Slot]];
+			Slot = Parents[Slot];
+		}
+		return Slot;
+	}
+
+	/** Union-find merge; the smaller slot becomes the root. */
+	static void Merge(TArray<int32>& Parents, int32 SlotA, int32 SlotB)
+	{
+		const int32 RootA = FindRoot(Parents, SlotA);
+		const int32 RootB = FindRoot(Parents, SlotB);
+		if (RootA != RootB)
+		{
+			Parents[FMath::Max(RootA, RootB)] = FMath::Min(RootA, RootB);
+		}
+	}
+
+	/** Inclusive cell box with flat slot addressing, used for the boundary slabs between two clusters. */
+	struct FSlab
+	{
+		FIntVector Min = FIntVector::ZeroValue;
+		FIntVector Max = FIntVector::ZeroValue;
+
+		FORCEINLINE FIntVector GetSize() const { return Max - Min + FIntVector(1, 1, 1); }
+		FORCEINLINE int32 GetNumSlots() const { const FIntVector Size = GetSize(); return Size.X * Size.Y * Size.Z; }
+
+		FORCEINLINE bool Contains(const FIntVector& Coordinates) const
+		{
+			return Coordinates.X >= Min.X && Coordinates.X <= Max.X
+				&& Coordinates.Y >= Min.Y && Coordinates.Y <= Max.Y
+				&& Coordinates.Z >= Min.Z && Coordinates.Z <= Max.Z;
+		}
+
+		FORCEINLINE int32 GetSlot(const FIntVector& Coordinates) const
+		{
+			const FIntVector Size = GetSize();
+			const FIntVector Local = Coordinates - Min;
+			return (Local.Z * Size.Y + Local.Y) * Size.X + Local.X;
+		}
+	};
+
+	/** A pair of adjacent free cells on either side of a cluster boundary. */
+	struct FCrossing
+	{
+		FIntVector LowCoordinates;
+		FIntVector HighCoordinates;
+		float Cost = 0.0f;
+		int32 LowRoot = INDEX_NONE;
+		int32 HighRoot = INDEX_NONE;
+	};
+}
+
+/**
+ * The abstract graph plus the query's temporary start and goal nodes, as an A* graph.
+ * Node ids past the abstract nodes: GetNumNodes() is the start, GetNumNodes() + 1 the goal.
+ */
+struct FNavClusterGraph::FAbstractSearchGraph
+{
+	FAbstractSearchGraph(const FNavClusterGraph& InGraph, const FNavGrid& InGrid, int32 InStartCell, int32 InGoalCell, int32 InGoalCluster)
+		: Graph(InGraph)
+		, Grid(InGrid)
+		, StartCell(InStartCell)
+		, GoalCell(InGoalCell)
+		, StartNode(InGraph.GetNumNodes())
+		, GoalNode(InGraph.GetNumNodes() + 1)
+		, GoalFirstNode(InGraph.ClusterFirstNode[InGoalCluster])
+		, GoalNumNodes(InGraph.ClusterFirstNode[InGoalCluster + 1] - GoalFirstNode)
+		, GoalCoordinates(InGrid.GetCoordinates(InGoalCell))
+	{
+	}
+
+	FORCEINLINE int32 GetNumNodes() const { return Graph.GetNumNodes() + 2; }
+
+	FORCEINLINE FIntVector GetPagedSize() const { return FIntVector::ZeroValue; }
+
+	FORCEINLINE int32 GetCell(int32 Node) const
+	{
+		return Node == StartNode ? StartCell : (Node == GoalNode ? GoalCell : Graph.NodeCells[Node]);
+	}
+
+	FORCEINLINE float GetHeuristic(int32 Node) const
+	{
+		return FVector::Distance(FVector(Grid.GetCoordinates(GetCell(Node))), GoalCoordinates);
+	}
+
+	template <typename FuncType>
+	void ForEachNeighbour(int32 Node, FuncType&& Func) const
+	{
+		if (Node == StartNode)
+		{
+			for (const FLink& Link : Graph.StartLinks)
+			{
+				Func(Link.Node, Link.Cost);
+			}
+			return;
+		}
+
+		if (Node == GoalNode)
+		{
+			return;
+		}
+
+		for (int32 LinkIndex = Graph.FirstLink[Node]; LinkIndex < Graph.FirstLink[Node + 1]; ++LinkIndex)
+		{
+			Func(Graph.Links[LinkIndex].Node, Graph.Links[LinkIndex].Cost);
+		}
+
+		// Nodes of the goal cluster also lead to the goal
+		const int32 GoalLocal = Node - GoalFirstNode;
+		if (GoalLocal >= 0 && GoalLocal < GoalNumNodes && Graph.GoalDistances[GoalLocal] < MAX_flt)
+		{
+			Func(GoalNode, Graph.GoalDistances[GoalLocal]);
+		}
+	}
+
+	const FNavClusterGraph& Graph;
+	const FNavGrid& Grid;
+	int32 StartCell;
+	int32 GoalCell;
+	int32 StartNode;
+	int32 GoalNode;
+	int32 GoalFirstNode;
+	int32 GoalNumNodes;
+	FVector GoalCoordinates;
+};
+
+//
+// ============================================================================
+// Build
+// ============================================================================
+//
+
+void FNavClusterGraph::Build(const FNavGrid& Grid, int32 InClusterSize, int32 InRequiredClearance, FNavSearchContext& Context)
+{
+	Reset();
+	if (!Grid.IsInitialized())
+	{
+		return;
+	}
+
+	ClusterSize = FMath::Max(InClusterSize, 2);
+	RequiredClearance = FMath::Max(InRequiredClearance, 1);
+
+	GridSize = Grid.GetSize();
+	NumClusters = FIntVector(
+		FMath::DivideAndRoundUp(GridSize.X, ClusterSize),
+		FMath::DivideAndRoundUp(GridSize.Y, ClusterSize),
+		FMath::DivideAndRoundUp(GridSize.Z, ClusterSize));
+
+	// One direction of each opposite pair, so every cluster pair is handled exactly once
+	for (int32 Z = -1; Z <= 1; ++Z)
+	{
+		for (int32 Y = -1; Y <= 1; ++Y)
+		{
+			for (int32 X = -1; X <= 1; ++X)
+			{
+				if (Z > 0 || (Z == 0 && Y > 0) || (Z == 0 && Y == 0 && X > 0))
+				{
+					PairDirections.Add(FIntVector(X, Y, Z));
+				}
+			}
+		}
+	}
+	check(PairDirections.Num() == NumPairDirections);
+
+	const int32 TotalClusters = NumClusters.X * NumClusters.Y * NumClusters.Z;
+	Clusters.SetNum(TotalClusters);
+	PairTransitions.SetNum(TotalClusters * NumPairDirections);
+
+	for (int32 Z = 0; Z < NumClusters.Z; ++Z)
+	{
+		for (int32 Y = 0; Y < NumClusters.Y; ++Y)
+		{
+			for (int32 X = 0; X < NumClusters.X; ++X)
+			{
+				for (int32 DirectionIndex = 0; DirectionIndex < NumPairDirections; ++DirectionIndex)
+				{
+					BuildTransitions(Grid, FIntVector(X, Y, Z), DirectionIndex);
+				}
+			}
+		}
+	}
+
+	for (int32 Z = 0; Z < NumClusters.Z; ++Z)
+	{
+		for (int32 Y = 0; Y < NumClusters.Y; ++Y)
+		{
+			for (int32 X = 0; X < NumClusters.X; ++X)
+			{
+				BuildCluster(Grid, FIntVector(X, Y, Z), Context);
+			}
+		}
+	}
+
+	BuildLinks(Grid);
+}
+
+void FNavClusterGraph::RebuildRegion(const FNavGrid& Grid, const FIntVector& DirtyMin, const FIntVector& DirtyMax, FNavSearchContext& Context)
+{
+	if (!IsBuilt())
+	{
+		return;
+	}
+
+	// Passability changes up to the clearance cap away from a changed bit; crossings one cell further
+	const int32 Pad = (Grid.HasClearanceLayer() ? Grid.GetMaxClearance() : 0) + 1;
+	const FIntVector LastCell = Grid.GetSize() - FIntVector(1, 1, 1);
+	const FIntVector DirtyClusterMin = GetClusterCoordinates(FIntVector(
+		FMath::Max(DirtyMin.X - Pad, 0),
+		FMath::Max(DirtyMin.Y - Pad, 0),
+		FMath::Max(DirtyMin.Z - Pad, 0)));
+	const FIntVector DirtyClusterMax = GetClusterCoordinates(FIntVector(
+		FMath::Min(DirtyMax.X + Pad, LastCell.X),
+		FMath::Min(DirtyMax.Y + Pad, LastCell.Y),
+		FMath::Min(DirtyMax.Z + Pad, LastCell.Z)));
+
+	auto IsDirty = [&DirtyClusterMin, &DirtyClusterMax](const FIntVector& Cluster)
+		{
+			return Cluster.X >= DirtyClusterMin.X && Cluster.X <= DirtyClusterMax.X
+				&& Cluster.Y >= DirtyClusterMin.Y && Cluster.Y <= DirtyClusterMax.Y
+				&& Cluster.Z >= DirtyClusterMin.Z && Cluster.Z <= DirtyClusterMax.Z;
+		};
+
+	// Dirty clusters plus one ring: the ring's transitions towards dirty clusters (and so its nodes) may change
+	const FIntVector RingMin(FMath::Max(DirtyClusterMin.X - 1, 0), FMath::Max(DirtyClusterMin.Y - 1, 0), FMath::Max(DirtyClusterMin.Z - 1, 0));
+	const FIntVector RingMax(
+		FMath::Min(DirtyClusterMax.X + 1, NumClusters.X - 1),
+		FMath::Min(DirtyClusterMax.Y + 1, NumClusters.Y - 1),
+		FMath::Min(DirtyClusterMax.Z + 1, NumClusters.Z - 1));
+
+	for (int32 Z = RingMin.Z; Z <= RingMax.Z; ++Z)
+	{
+		for (int32 Y = RingMin.Y; Y <= RingMax.Y; ++Y)
+		{
+			for (int32 X = RingMin.X; X <= RingMax.X; ++X)
+			{
+				const FIntVector Cluster(X, Y, Z);
+				for (int32 DirectionIndex = 0; DirectionIndex < NumPairDirections; ++DirectionIndex)
+				{
+					if (IsDirty(Cluster) || IsDirty(Cluster + PairDirections[DirectionIndex]))
+					{
+						BuildTransitions(Grid, Cluster, DirectionIndex);
+					}
+				}
+			}
+		}
+	}
+
+	for (int32 Z = RingMin.Z; Z <= RingMax.Z; ++Z)
+	{
+		for (int32 Y = RingMin.Y; Y <= RingMax.Y; ++Y)
+		{
+			for (int32 X = RingMin.X; X <= RingMax.X; ++X)
+			{
+				BuildCluster(Grid, FIntVector(X, Y, Z), Context);
+			}
+		}
+	}
+
+	BuildLinks(Grid);
+}
+
+void FNavClusterGraph::Reset()
+{
+	GridSize = FIntVector::ZeroValue;
+	NumClusters = FIntVector::ZeroValue;
+	PairDirections.Reset();
+	Clusters.Empty();
+	PairTransitions.Empty();
+	ClusterFirstNode.Empty();
+	NodeCells.Empty();
+	FirstLink.Empty();
+	Links.Empty();
+}
+
+void FNavClusterGraph::GetClusterCellRange(const FIntVector& ClusterCoordinates, FIntVector& OutMin, FIntVector& OutMax) const
+{
+	OutMin = ClusterCoordinates * ClusterSize;
+	OutMax = OutMin + FIntVector(ClusterSize - 1, ClusterSize - 1, ClusterSize - 1);
+
+	// Clusters on the far faces are cut by the grid
+	OutMax.X = FMath::Min(OutMax.X, GridSize.X - 1);
+	OutMax.Y = FMath::Min(OutMax.Y, GridSize.Y - 1);
+	OutMax.Z = FMath::Min(OutMax.Z, GridSize.Z - 1);
+}
+
+void FNavClusterGraph::BuildTransitions(const FNavGrid& Grid, const FIntVector& ClusterCoordinates, int32 DirectionIndex)
+{
+	using namespace NavClusterGraph;
+
+	TArray<FNavClusterTransition>& Transitions = PairTransitions[GetClusterIndex(ClusterCoordinates) * NumPairDirections + DirectionIndex];
+	Transitions.Reset();
+
+	const FIntVector Direction = PairDirections[DirectionIndex];
+	const FIntVector OtherCluster = ClusterCoordinates + Direction;
+	if (!IsValidCluster(OtherCluster))
+	{
+		return;
+	}
+
+	// -------------------------------------------------------
+	// Boundary slabs: the cells of each cluster that can touch the other one
+	// -------------------------------------------------------
+	FIntVector LowMin, LowMax, HighMin, HighMax;
+	GetClusterCellRange(ClusterCoordinates, LowMin, LowMax);
+	GetClusterCellRange(OtherCluster, HighMin, HighMax);
+
+	FSlab LowSlab{ LowMin, LowMax };
+	FSlab HighSlab{ HighMin, HighMax };
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		if (Direction[Axis] > 0)
+		{
+			LowSlab.Min[Axis] = LowMax[Axis];
+			HighSlab.Max[Axis] = HighMin[Axis];
+		}
+		else if (Direction[Axis] < 0)
+		{
+			LowSlab.Max[Axis] = LowMin[Axis];
+			HighSlab.Min[Axis] = HighMax[Axis];
+		}
+	}
+
+	// -------------------------------------------------------
+	// Crossings: free cell pairs linked by a grid neighbour offset
+	// -------------------------------------------------------
+	const TArray<FNavGridNeighbour>& Offsets = Grid.GetNeighbourOffsets();
+	TArray<FCrossing> Crossings;
+	TArray<int32> LowParents;
+	TArray<int32> HighParents;
+	LowParents.Init(INDEX_NONE, LowSlab.GetNumSlots());
+	HighParents.Init(INDEX_NONE, HighSlab.GetNumSlots());
+
+	for (int32 Z = LowSlab.Min.Z; Z <= LowSlab.Max.Z; ++Z)
+	{
+		for (int32 Y = LowSlab.Min.Y; Y <= LowSlab.Max.Y; ++Y)
+		{
+			for (int32 X = LowSlab.Min.X; X <= LowSlab.Max.X; ++X)
+			{
+				const FIntVector Low(X, Y, Z);
+				const int32 LowIndex = Grid.GetIndex(Low);
+				if (!Grid.IsPassable(LowIndex, RequiredClearance))
+				{
+					continue;
+				}
+
+				for (const FNavGridNeighbour& Offset : Offsets)
+				{
+					const FIntVector High = Low + Offset.Offset;
+					if (!HighSlab.Contains(High) || !Grid.IsPassable(LowIndex + Offset.IndexDelta, RequiredClearance))
+					{
+						continue;
+					}
+
+					FCrossing& Crossing = Crossings.AddDefaulted_GetRef();
+					Crossing.LowCoordinates = Low;
+					Crossing.HighCoordinates = High;
+					Crossing.Cost = Offset.Cost;
+
+					const int32 LowSlot = LowSlab.GetSlot(Low);
+					const int32 HighSlot = HighSlab.GetSlot(High);
+					LowParents[LowSlot] = LowSlot;
+					HighParents[HighSlot] = HighSlot;
+				}
+			}
+		}
+	}
+
+	if (Crossings.Num() == 0)
+	{
+		return;
+	}
+
+	// -------------------------------------------------------
+	// Group crossings whose cells are connected on both sides: any path over one crossing
+	// of a group can be rerouted over another one without leaving the two clusters
+	// -------------------------------------------------------
+	auto MergeAdjacent = [&Offsets](const FSlab& Slab, TArray<int32>& Parents, const FIntVector& Coordinates)
+		{
+			const int32 Slot = Slab.GetSlot(Coordinates);
+			for (const FNavGridNeighbour& Offset : Offsets)
+			{
+				const FIntVector Neighbour = Coordinates + Offset.Offset;
+				if (Slab.Contains(Neighbour))
+				{
+					const int32 NeighbourSlot = Slab.GetSlot(Neighbour);
+					if (Parents[NeighbourSlot] != INDEX_NONE)
+					{
+						Merge(Parents, Slot, NeighbourSlot);
+					}
+				}
+			}
+		};
+
+	for (const FCrossing& Crossing : Crossings)
+	{
+		MergeAdjacent(LowSlab, LowParents, Crossing.LowCoordinates);
+		MergeAdjacent(HighSlab, HighParents, Crossing.HighCoordinates);
+	}
+
+	for (FCrossing& Crossing : Crossings)
+	{
+		Crossing.LowRoot = FindRoot(LowParents, LowSlab.GetSlot(Crossing.LowCoordinates));
+		Crossing.HighRoot = FindRoot(HighParents, HighSlab.GetSlot(Crossing.HighCoordinates));
+	}
+
+	Crossings.Sort([](const FCrossing& A, const FCrossing& B)
+		{
+			return A.LowRoot != B.LowRoot ? A.LowRoot < B.LowRoot : A.HighRoot < B.HighRoot;
+		});
+
+	// One transition per group: the crossing closest to the group's middle
+	for (int32 GroupStart = 0; GroupStart < Crossings.Num(); )
+	{
+		int32 GroupEnd = GroupStart + 1;
+		FVector Sum = FVector(Crossings[GroupStart].LowCoordinates + Crossings[GroupStart].HighCoordinates);
+		while (GroupEnd < Crossings.Num()
+			&& Crossings[GroupEnd].LowRoot == Crossings[GroupStart].LowRoot
+			&& Crossings[GroupEnd].HighRoot == Crossings[GroupStart].HighRoot)
+		{
+			Sum += FVector(Crossings[GroupEnd].LowCoordinates + Crossings[GroupEnd].HighCoordinates);
+			++GroupEnd;
+		}
+
+		const FVector Middle = Sum / (GroupEnd - GroupStart);
+		int32 Best = GroupStart;
+		double BestDistSq = MAX_dbl;
+		for (int32 Index = GroupStart; Index < GroupEnd; ++Index)
+		{
+			const FCrossing& Crossing = Crossings[Index];
+			const double DistSq = FVector::DistSquared(FVector(Crossing.LowCoordinates + Crossing.HighCoordinates), Middle);
+			if (DistSq < BestDistSq || (DistSq == BestDistSq && Crossing.Cost < Crossings[Best].Cost))
+			{
+				Best = Index;
+				BestDistSq = DistSq;
+			}
+		}
+
+		FNavClusterTransition& Transition = Transitions.AddDefaulted_GetRef();
+		Transition.LowCell = Grid.GetIndex(Crossings[Best].LowCoordinates);
+		Transition.HighCell = Grid.GetIndex(Crossings[Best].HighCoordinates);
+		Transition.Cost = Crossings[Best].Cost;
+
+		GroupStart = GroupEnd;
+	}
+}
+
+void FNavClusterGraph::BuildCluster(const FNavGrid& Grid, const FIntVector& ClusterCoordinates, FNavSearchContext& Context)
+{
+	const int32 ClusterIndex = GetClusterIndex(ClusterCoordinates);
+	FCluster& Cluster = Clusters[ClusterIndex];
+	Cluster.Cells.Reset();
+
+	// Transition cells on this side of every neighbouring pair (stored here or at the neighbour)
+	for (int32 DirectionIndex = 0; DirectionIndex < NumPairDirections; ++DirectionIndex)
+	{
+		for (const FNavClusterTransition& Transition : PairTransitions[ClusterIndex * NumPairDirections + DirectionIndex])
+		{
+			Cluster.Cells.Add(Transition.LowCell);
+		}
+
+		const FIntVector OtherCluster = ClusterCoordinates - PairDirections[DirectionIndex];
+		if (IsValidCluster(OtherCluster))
+		{
+			for (const FNavClusterTransition& Transition : PairTransitions[GetClusterIndex(OtherCluster) * NumPairDirections + DirectionIndex])
+			{
+				Cluster.Cells.Add(Transition.HighCell);
+			}
+		}
+	}
+
+	Cluster.Cells.Sort();
+	Cluster.Cells.SetNum(Algo::Unique(Cluster.Cells), EAllowShrinking::No);
+
+	// Distances between every pair of transition cells, one Dijkstra per cell
+	const int32 NumCells = Cluster.Cells.Num();
+	Cluster.Distances.SetNumUninitialized(NumCells * NumCells);
+	for (int32 From = 0; From < NumCells; ++From)
+	{
+		SearchCluster(Grid, Context, Cluster.Cells[From]);
+		for (int32 To = 0; To < NumCells; ++To)
+		{
+			Cluster.Distances[From * NumCells + To] = Context.GetGScore(Cluster.Cells[To]);
+		}
+	}
+}
+
+void FNavClusterGraph::BuildLinks(const FNavGrid& Grid)
+{
+	// -------------------------------------------------------
+	// Node ids: the transition cells of cluster 0, then cluster 1, ...
+	// -------------------------------------------------------
+	ClusterFirstNode.SetNum(Clusters.Num() + 1);
+	NodeCells.Reset();
+	for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ++ClusterIndex)
+	{
+		ClusterFirstNode[ClusterIndex] = NodeCells.Num();
+		NodeCells.Append(Clusters[ClusterIndex].Cells);
+	}
+	ClusterFirstNode[Clusters.Num()] = NodeCells.Num();
+
+	// -------------------------------------------------------
+	// Directed links: reachable pairs inside a cluster, both ways over every transition
+	// -------------------------------------------------------
+	TArray<TPair<int32, FLink>> DirectedLinks;
+	for (int32 ClusterIndex = 0; ClusterIndex < Clusters.Num(); ++ClusterIndex)
+	{
+		const FCluster& Cluster = Clusters[ClusterIndex];
+		const int32 FirstNode = ClusterFirstNode[ClusterIndex];
+		const int32 NumCells = Cluster.Cells.Num();
+		for (int32 From = 0; From < NumCells; ++From)
+		{
+			for (int32 To = 0; To < NumCells; ++To)
+			{
+				const float Distance = Cluster.Distances[From * NumCells + To];
+				if (From != To && Distance < MAX_flt)
+				{
+					DirectedLinks.Add(TPair<int32, FLink>(FirstNode + From, FLink{ FirstNode + To, Distance }));
+				}
+			}
+		}
+	}
+
+	for (const TArray<FNavClusterTransition>& Transitions : PairTransitions)
+	{
+		for (const FNavClusterTransition& Transition : Transitions)
+		{
+			const int32 LowNode = FindNode(Grid, Transition.LowCell);
+			const int32 HighNode = FindNode(Grid, Transition.HighCell);
+			check(LowNode != INDEX_NONE && HighNode != INDEX_NONE);
+			DirectedLinks.Add(TPair<int32, FLink>(LowNode, FLink{ HighNode, Transition.Cost }));
+			DirectedLinks.Add(TPair<int32, FLink>(HighNode, FLink{ LowNode, Transition.Cost }));
+		}
+	}
+
+	// -------------------------------------------------------
+	// Group by source node (counting sort into compressed rows)
+	// -------------------------------------------------------
+	FirstLink.Init(0, NodeCells.Num() + 1);
+	for (const TPair<int32, FLink>& Link : DirectedLinks)
+	{
+		++FirstLink[Link.Key + 1];
+	}
+	for (int32 Node = 0; Node < NodeCells.Num(); ++Node)
+	{
+		FirstLink[Node + 1] += FirstLink[Node];
+	}
+
+	TArray<int32> Cursor(FirstLink.GetData(), NodeCells.Num());
+	Links.SetNumUninitialized(DirectedLinks.Num());
+	for (const TPair<int32, FLink>& Link : DirectedLinks)
+	{
+		Links[Cursor[Link.Key]++] = Link.Value;
+	}
+}
+
+int32 FNavClusterGraph::FindNode(const FNavGrid& Grid, int32 Cell) const
+{
+	const int32 ClusterIndex = GetClusterIndex(GetClusterCoordinates(Grid.GetCoordinates(Cell)));
+	const int32 Local = Algo::BinarySearch(Clusters[ClusterIndex].Cells, Cell);
+	return Local != INDEX_NONE ? ClusterFirstNode[ClusterIndex] + Local : INDEX_NONE;
+}
+
+void FNavClusterGraph::SearchCluster(const FNavGrid& Grid, FNavSearchContext& Context, int32 SourceCell) const
+{
+	FIntVector Min, Max;
+	GetClusterCellRange(GetClusterCoordinates(Grid.GetCoordinates(SourceCell)), Min, Max);
+
+	// No goal: the search runs until the cluster is exhausted
+	const NavClusterGraph::FClusterSearchGraph Graph(Grid, RequiredClearance, Min, Max);
+	FNavPathfinder::FindGraphPath(Graph, Context, SourceCell, INDEX_NONE);
+}
+
+//
+// ============================================================================
+// Query
+// ============================================================================
+//
+
+bool FNavClusterGraph::FindPath(const FNavGrid& Grid, FNavSearchContext& Context, int32 StartCell, int32 GoalCell, const std::atomic<bool>* CancelFlag)
+{
+	if (!IsBuilt())
+	{
+		return false;
+	}
+
+	const FIntVector StartCluster = GetClusterCoordinates(Grid.GetCoordinates(StartCell));
+	const FIntVector GoalCluster = GetClusterCoordinates(Grid.GetCoordinates(GoalCell));
+	int32 NumExpanded = 0;
+
+	// -------------------------------------------------------
+	// Same or neighbouring clusters: a search inside those clusters is usually enough,
+	// and avoids detours through transition cells on short queries
+	// -------------------------------------------------------
+	const FIntVector ClusterDelta = GoalCluster - StartCluster;
+	if (FMath::Max3(FMath::Abs(ClusterDelta.X), FMath::Abs(ClusterDelta.Y), FMath::Abs(ClusterDelta.Z)) <= 1)
+	{
+		FIntVector StartMin, StartMax, GoalMin, GoalMax;
+		GetClusterCellRange(StartCluster, StartMin, StartMax);
+		GetClusterCellRange(GoalCluster, GoalMin, GoalMax);
+		const FIntVector Min(FMath::Min(StartMin.X, GoalMin.X), FMath::Min(StartMin.Y, GoalMin.Y), FMath::Min(StartMin.Z, GoalMin.Z));
+		const FIntVector Max(FMath::Max(StartMax.X, GoalMax.X), FMath::Max(StartMax.Y, GoalMax.Y), FMath::Max(StartMax.Z, GoalMax.Z));
+		const NavClusterGraph::FClusterSearchGraph Graph(Grid, RequiredClearance, Min, Max, GoalCell);
+		if (FNavPathfinder::FindGraphPath(Graph, Context, StartCell, GoalCell, CancelFlag))
+		{
+			return true;
+		}
+		NumExpanded += Context.NumExpanded;
+	}
+
+	// -------------------------------------------------------
+	// Link start and goal to the transition cells of their clusters
+	// -------------------------------------------------------
+	const int32 GoalClusterIndex = GetClusterIndex(GoalCluster);
+	const FCluster& GoalClusterData = Clusters[GoalClusterIndex];
+	SearchCluster(Grid, Context, GoalCell);
+	NumExpanded += Context.NumExpanded;
+	GoalDistances.SetNumUninitialized(GoalClusterData.Cells.Num(), EAllowShrinking::No);
+	for (int32 Local = 0; Local < GoalClusterData.Cells.Num(); ++Local)
+	{
+		GoalDistances[Local] = Context.GetGScore(GoalClusterData.Cells[Local]);
+	}
+
+	const int32 StartClusterIndex = GetClusterIndex(StartCluster);
+	const FCluster& StartClusterData = Clusters[StartClusterIndex];
+	SearchCluster(Grid, Context, StartCell);
+	NumExpanded += Context.NumExpanded;
+	StartLinks.Reset();
+	for (int32 Local = 0; Local < StartClusterData.Cells.Num(); ++Local)
+	{
+		const float Distance = Context.GetGScore(StartClusterData.Cells[Local]);
+		if (Distance < MAX_flt)
+		{
+			StartLinks.Add(FLink{ ClusterFirstNode[StartClusterIndex] + Local, Distance });
+		}
+	}
+
+	// -------------------------------------------------------
+	// Coarse plan over the abstract graph
+	// -------------------------------------------------------
+	const FAbstractSearchGraph AbstractGraph(*this, Grid, StartCell, GoalCell, GoalClusterIndex);
+	const bool bFound = FNavPathfinder::FindGraphPath(AbstractGraph, AbstractContext, AbstractGraph.StartNode, AbstractGraph.GoalNode, CancelFlag);
+	NumExpanded += AbstractContext.NumExpanded;
+	if (!bFound)
+	{
+		// A start the agent does not fit in (e.g. touching a wall) is only linked through its own
+		// cluster, but may still step straight into a neighbouring one: settle it on the full grid
+		if (!Grid.IsPassable(StartCell, RequiredClearance) && !(CancelFlag && CancelFlag->load(std::memory_order_relaxed)))
+		{
+			FNavPathQuery Query;
+			Query.StartNode = StartCell;
+			Query.GoalNode = GoalCell;
+			Query.RequiredClearance = RequiredClearance;
+			Query.CancelFlag = CancelFlag;
+			return FNavPathfinder::FindPath(Grid, Context, Query);
+		}
+
+		Context.NumExpanded = NumExpanded;
+		return false;
+	}
+
+	// -------------------------------------------------------
+	// Refine: each intra-cluster leg is searched inside its cluster only,
+	// transitions are single steps between adjacent cells
+	// -------------------------------------------------------
+	RefinedPath.Reset();
+	RefinedPath.Add(StartCell);
+	const TArray<int32>& AbstractPath = AbstractContext.PathNodes;
+	for (int32 Index = 1; Index < AbstractPath.Num(); ++Index)
+	{
+		const int32 FromCell = AbstractGraph.GetCell(AbstractPath[Index - 1]);
+		const int32 ToCell = AbstractGraph.GetCell(AbstractPath[Index]);
+		if (FromCell == ToCell)
+		{
+			continue;
+		}
+
+		const FIntVector LegCluster = GetClusterCoordinates(Grid.GetCoordinates(FromCell));
+		if (LegCluster != GetClusterCoordinates(Grid.GetCoordinates(ToCell)))
+		{
+			RefinedPath.Add(ToCell);
+			continue;
+		}
+
+		FIntVector Min, Max;
+		GetClusterCellRange(LegCluster, Min, Max);
+		const NavClusterGraph::FClusterSearchGraph Graph(Grid, RequiredClearance, Min, Max, ToCell);
+		verifyf(FNavPathfinder::FindGraphPath(Graph, Context, FromCell, ToCell),
+			TEXT("FNavClusterGraph: abstract link without a path inside its cluster; the graph is out of date."));
+		NumExpanded += Context.NumExpanded;
+
+		for (int32 PathIndex = 1; PathIndex < Context.PathNodes.Num(); ++PathIndex)
+		{
+			RefinedPath.Add(Context.PathNodes[PathIndex]);
+		}
+	}
+
+	Context.PathNodes.Reset();
+	Context.PathNodes.Append(RefinedPath);
+	Context.NumExpanded = NumExpanded;
+	return true;
+}
@@ -0,0 +1,152 @@
+#include "NavComponentLabels.h"
+#include "NavGrid.h"
+
+void FNavComponentLabels::Build(const FNavGrid& Grid, int32 InRequiredClearance)
+{
+	RequiredClearance = InRequiredClearance;
+	NumComponents = 0;
+
+	// Union-find forest in Labels: every passable cell starts as its own root
+	const int32 NumCells = Grid.GetNumCells();
+	Labels.SetNumUninitialized(NumCells);
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		Labels[Cell] = Grid.IsPassable(Cell, RequiredClearance) ? Cell : INDEX_NONE;
+	}
+
+	// Path halving; parents always have a lower index than their children
+	auto FindRoot = [this](int32 Cell)
+		{
+			while (Labels[Cell] != Cell)
+			{
+				Labels[Cell] = Labels[Labels[Cell]];
+				Cell = Labels[Cell];
+			}
+			return Cell;
+		};
+
+	// Links are symmetric, so each one is merged once, from its higher cell. The higher root joins the lower one.
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		if (Labels[Cell] == INDEX_NONE)
+		{
+			continue;
+		}
+
+		Grid.ForEachNeighbour(Cell, [this, &FindRoot, Cell](int32 Neighbour, float)
+			{
+				if (Neighbour < Cell && Labels[Neighbour] != INDEX_NONE)
+				{
+					const int32 CellRoot = FindRoot(Cell);
+					const int32 NeighbourRoot = FindRoot(Neighbour);
+					if (CellRoot != NeighbourRoot)
+					{
+						Labels[FMath::Max(CellRoot, NeighbourRoot)] = FMath::Min(CellRoot, NeighbourRoot);
+					}
+				}
+			});
+	}
+
+	// Flatten in index order: a root is the lowest cell of its component and gets the next label;
+	// every other cell's parent is lower and already holds its final label
+	for (int32 Cell = 0; Cell < NumCells; ++Cell)
+	{
+		const int32 Parent = Labels[Cell];
+		if (Parent == INDEX_NONE)
+		{
+			continue;
+		}
+		Labels[Cell] = (Parent == Cell) ? NumComponents++ : Labels[Parent];
+	}
+}
+
+void FNavComponentLabels::Reset()
+{
+	Labels.Empty();
+	NumComponents = 0;
+	RequiredClearance = 0;
+}
+
+void FNavComponentLabels::Serialize(FArchive& Ar)
+{
+	Ar << RequiredClearance << NumComponents;
+
+	// Runs of equal labels in cell order, as (label, length) pairs
+	TArray<int32> Runs;
+	if (!Ar.IsLoading())
+	{
+		for (int32 Cell = 0; Cell < Labels.Num(); )
+		{
+			const int32 RunStart = Cell;
+			while (Cell < Labels.Num() && Labels[Cell] == Labels[RunStart])
+			{
+				++Cell;
+			}
+			Runs.Add(Labels[RunStart]);
+			Runs.Add(Cell - RunStart);
+		}
+	}
+	Runs.BulkSerialize(Ar);
+
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	// Every label must name a component and the runs must fit an addressable grid
+	int64 NumCellsLoaded = 0;
+	bool bValid = !Ar.IsError() && RequiredClearance >= 0 && NumComponents >= 0 && Runs.Num() % 2 == 0;
+	for (int32 Index = 0; bValid && Index < Runs.Num(); Index += 2)
+	{
+		NumCellsLoaded += Runs[Index + 1];
+		bValid = Runs[Index] >= INDEX_NONE && Runs[Index] < NumComponents
+			&& Runs[Index + 1] > 0 && NumCellsLoaded <= MAX_int32;
+	}
+
+	if (!bValid)
+	{
+		Ar.SetError();
+		Reset();
+		return;
+	}
+
+	Labels.Reset(static_cast<int32>(NumCellsLoaded));
+	for (int32 Index = 0; Index < Runs.Num(); Index += 2)
+	{
+		for (int32 Count = 0; Count < Runs[Index + 1]; ++Count)
+		{
+			Labels.Add(Runs[Index]);
+		}
+	}
+}
+
+void FNavComponentLabels::GetComponentsFrom(const FNavGrid& Grid, int32 Cell, FComponentList& OutComponents) const
+{
+	OutComponents.Reset();
+	if (Labels[Cell] != INDEX_NONE)
+	{
+		OutComponents.Add(Labels[Cell]);
+		return;
+	}
+
+	// A* expands the start whether the agent fits there or not, so it enters every neighbouring component
+	Grid.ForEachNeighbour(Cell, [this, &OutComponents](int32 Neighbour, float)
+		{
+			if (Labels[Neighbour] != INDEX_NONE)
+			{
+				OutComponents.AddUnique(Labels[Neighbour]);
+			}
+		});
+}
+
+bool FNavComponentLabels::AreConnected(const FNavGrid& Grid, int32 FromCell, int32 ToCell) const
+{
+	if (FromCell == ToCell)
+	{
+		return true;
+	}
+
+	FComponentList Components;
+	GetComponentsFrom(Grid, FromCell, Components);
+	return Labels[ToCell] != INDEX_NONE && Components.Contains(Labels[ToCell]);
+}
@@ -0,0 +1,90 @@
+#include "NavFlowField.h"
+#include "NavGrid.h"
+
+void FNavFlowField::Begin(const FNavGrid& Grid, int32 InGoalCell, int32 InRequiredClearance, float InMaxCost)
+{
+	checkf(InGoalCell >= 0 && InGoalCell < Grid.GetNumCells(), TEXT("FNavFlowField: goal cell %d outside the grid"), InGoalCell);
+
+	GoalCell = InGoalCell;
+	RequiredClearance = InRequiredClearance;
+	MaxCost = FMath::Max(InMaxCost, 0.0f);
+
+	Context.BeginSearch(Grid.GetNumCells(), Grid.GetSearchPagedSize());
+	if (Grid.IsPassable(GoalCell, RequiredClearance))
+	{
+		Context.Touch(GoalCell).GScore = 0.0f;
+		Context.OpenSet.Push(GoalCell, 0.0f);
+	}
+}
+
+bool FNavFlowField::Step(const FNavGrid& Grid, int32 MaxExpansions)
+{
+	if (!IsStarted())
+	{
+		return false;
+	}
+
+	// Moves cost the same both ways, so searching outward from the goal gives every cell its cost
+	// to the goal; a cell's parent is its next step
+	FNavOpenSet& OpenSet = Context.OpenSet;
+	int32 NumExpansions = 0;
+	while (!OpenSet.IsEmpty() && (MaxExpansions <= 0 || NumExpansions < MaxExpansions))
+	{
+		// Everything left is beyond the bound
+		if (MaxCost > 0.0f && OpenSet.GetMinKey() > MaxCost)
+		{
+			OpenSet.Reset(Grid.GetNumCells(), Grid.GetSearchPagedSize());
+			break;
+		}
+
+		const int32 CurrentCell = OpenSet.Pop();
+		FNavSearchNode& CurrentState = Context.Touch(CurrentCell);
+		CurrentState.bClosed = true;
+		++Context.NumExpanded;
+		++NumExpansions;
+
+		const float CurrentCost = CurrentState.GScore;
+		Grid.ForEachNeighbour(CurrentCell, [this, &Grid, &OpenSet, CurrentCell, CurrentCost](int32 Neighbour, float EdgeCost)
+			{
+				if (Context.IsClosed(Neighbour) || !Grid.IsPassable(Neighbour, RequiredClearance))
+				{
+					return;
+				}
+
+				const float TentativeCost = CurrentCost + EdgeCost;
+				FNavSearchNode& NeighbourState = Context.Touch(Neighbour);
+				if (TentativeCost < NeighbourState.GScore)
+				{
+					NeighbourState.GScore = TentativeCost;
+					NeighbourState.Parent = CurrentCell;
+					OpenSet.PushOrDecrease(Neighbour, TentativeCost);
+				}
+			});
+	}
+
+	return OpenSet.IsEmpty();
+}
+
+void FNavFlowField::Reset()
+{
+	Context = FNavSearchContext();
+	GoalCell = INDEX_NONE;
+	RequiredClearance = 0;
+	MaxCost = 0.0f;
+}
+
+int32 FNavFlowField::FindBestNeighbour(const FNavGrid& Grid, int32 Cell) const
+{
+	int32 BestCell = INDEX_NONE;
+	float BestCost = MAX_flt;
+	Grid.ForEachNeighbour(Cell, [this, &BestCell, &BestCost](int32 Neighbour, float EdgeCost)
+		{
+			const float Cost = GetCost(Neighbour) + EdgeCost;
+			if (IsSettled(Neighbour) && Cost < BestCost)
+			{
+				BestCell = Neighbour;
+				BestCost = Cost;
+			}
+		});
+	return BestCell;
+}
@@ -0,0 +1,658 @@
+#include "NavGrid.h"
+#include "NavBakedDataVersion.h"
+
+void FNavGrid::Init(int32 InSizeX, int32 InSizeY, int32 InSizeZ, int32 InMinSharedNeighborAxes, const FVector& InOrigin, float InCellSize, bool bInBrickStorage)
+{
+	SizeX = FMath::Max(InSizeX, 1);
+	SizeY = FMath::Max(InSizeY, 1);
+	SizeZ = FMath::Max(InSizeZ, 1);
+	NumCells = SizeX * SizeY * SizeZ;
+
+	// Precompute the affine grid -> world transform (cell centers are offset by half a cell)
+	CellSize = FMath::Max(InCellSize, KINDA_SMALL_NUMBER);
+	InvCellSize = 1.0f / CellSize;
+	Origin = InOrigin;
+	CellCenterOrigin = InOrigin + FVector(CellSize * 0.5f);
+
+	// All cells start walkable: zeroed bits, or every brick uniformly free
+	BlockedBits.Reset();
+	Clearance.Reset();
+	BrickBitOffsets.Reset();
+	BrickBits.Reset();
+	FreeBitBlocks.Reset();
+	BrickClearanceOffsets.Reset();
+	BrickClearance.Reset();
+	FreeClearanceBlocks.Reset();
+
+	bBrickStorage = bInBrickStorage;
+	if (bBrickStorage)
+	{
+		NumBricksX = (SizeX + BrickMask) >> BrickShift;
+		NumBricksY = (SizeY + BrickMask) >> BrickShift;
+		NumBricksZ = (SizeZ + BrickMask) >> BrickShift;
+		BrickBitOffsets.Init(UniformFreeBrick, NumBricksX * NumBricksY * NumBricksZ);
+	}
+	else
+	{
+		NumBricksX = NumBricksY = NumBricksZ = 0;
+		BlockedBits.SetNumZeroed((NumCells + 63) / 64);
+	}
+
+	MinSharedNeighborAxes = InMinSharedNeighborAxes;
+	BuildNeighbourOffsets();
+}
+
+void FNavGrid::BuildNeighbourOffsets()
+{
+	// Precomputed neighbour offset list for 3D grid adjacency:
+	//  - Above, middle, below layers.
+	//  - Only offsets sharing enough axes with the source cell are kept (e.g., 6- or 18-connected).
+	static const FIntVector NeighbourOffsets[] = {
+		// Above (z + 1)
+	   { 1, -1,  1}, { 1,  0,  1}, { 1,  1,  1},
+	   { 0, -1,  1}, { 0,  0,  1}, { 0,  1,  1},
+	   {-1, -1,  1}, {-1,  0,  1}, {-1,  1,  1},
+
+	   // Middle (z)
+	   { 1, -1,  0}, { 1,  0,  0}, { 1,  1,  0},
+	   { 0, -1,  0},               { 0,  1,  0},
+	   {-1, -1,  0}, {-1,  0,  0}, {-1,  1,  0},
+
+	   // Below (z - 1)
+	   { 1, -1, -1}, { 1,  0, -1}, { 1,  1, -1},
+	   { 0, -1, -1}, { 0,  0, -1}, { 0,  1, -1},
+	   {-1, -1, -1}, {-1,  0, -1}, {-1,  1, -1}
+	};
+
+	Neighbours.Reset();
+	for (const FIntVector& Offset : NeighbourOffsets)
+	{
+		// Count how many axes are shared with the candidate node
+		const int32 SharedAxes = (Offset.X == 0) + (Offset.Y == 0) + (Offset.Z == 0);
+		if (SharedAxes < MinSharedNeighborAxes)
+		{
+			continue;
+		}
+
+		FNavGridNeighbour& Neighbour = Neighbours.AddDefaulted_GetRef();
+		Neighbour.Offset = Offset;
+		Neighbour.IndexDelta = GetIndex(Offset);
+		Neighbour.Cost = FMath::Sqrt(static_cast<float>(3 - SharedAxes));
+	}
+}
+
+bool FNavGrid::GetCellRangeInBox(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const
+{
+	// Cell i has its center at Origin + (i + 0.5) * CellSize. Returns the first cell whose center is >= Bound:
+	// estimate it analytically, then correct by comparing against the exact center values GetCellCenter
+	// produces, so boxes whose faces fall exactly on cell centers are resolved consistently.
+	auto FirstCellAtOrAbove = [this](double Bound, int32 Axis, int32 AxisSize)
+		{
+			const double AxisOrigin = CellCenterOrigin[Axis];
+			int32 Cell = FMath::Clamp(FMath::CeilToInt((Bound - AxisOrigin) * InvCellSize), 0, AxisSize);
+			while (Cell > 0 && AxisOrigin + static_cast<double>(Cell - 1) * CellSize >= Bound)
+			{
+				--Cell;
+			}
+			while (Cell < AxisSize && AxisOrigin + static_cast<double>(Cell) * CellSize < Bound)
+			{
+				++Cell;
+			}
+			return Cell;
+		};
+
+	const int32 Sizes[3] = { SizeX, SizeY, SizeZ };
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		OutMin[Axis] = FirstCellAtOrAbove(Box.Min[Axis], Axis, Sizes[Axis]);
+		OutMax[Axis] = FirstCellAtOrAbove(Box.Max[Axis], Axis, Sizes[Axis]) - 1;
+	}
+
+	return OutMin.X <= OutMax.X && OutMin.Y <= OutMax.Y && OutMin.Z <= OutMax.Z;
+}
+
+void FNavGrid::SetBlockedRange(const FIntVector& Min, const FIntVector& Max, bool bBlocked)
+{
+	if (!bBrickStorage)
+	{
+		for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				const int32 RowStart = GetIndex(FIntVector(0, Y, Z));
+				for (int32 X = Min.X; X <= Max.X; ++X)
+				{
+					SetBlocked(RowStart + X, bBlocked);
+				}
+			}
+		}
+		return;
+	}
+
+	// Bricks fully inside the range become uniform; partially covered bricks are edited bit by bit
+	const int32 Uniform = bBlocked ? UniformBlockedBrick : UniformFreeBrick;
+	for (int32 BrickZ = Min.Z >> BrickShift; BrickZ <= Max.Z >> BrickShift; ++BrickZ)
+	{
+		for (int32 BrickY = Min.Y >> BrickShift; BrickY <= Max.Y >> BrickShift; ++BrickY)
+		{
+			for (int32 BrickX = Min.X >> BrickShift; BrickX <= Max.X >> BrickShift; ++BrickX)
+			{
+				const int32 Brick = (BrickZ * NumBricksY + BrickY) * NumBricksX + BrickX;
+				FIntVector BrickMin, BrickMax;
+				GetBrickCellRange(BrickX, BrickY, BrickZ, BrickMin, BrickMax);
+
+				const FIntVector RangeMin(FMath::Max(Min.X, BrickMin.X), FMath::Max(Min.Y, BrickMin.Y), FMath::Max(Min.Z, BrickMin.Z));
+				const FIntVector RangeMax(FMath::Min(Max.X, BrickMax.X), FMath::Min(Max.Y, BrickMax.Y), FMath::Min(Max.Z, BrickMax.Z));
+				const int32 Offset = BrickBitOffsets[Brick];
+				if (RangeMin == BrickMin && RangeMax == BrickMax)
+				{
+					if (Offset >= 0)
+					{
+						FreeBitBlocks.Add(Offset);
+					}
+					BrickBitOffsets[Brick] = Uniform;
+					continue;
+				}
+
+				if (Offset == Uniform)
+				{
+					continue;
+				}
+
+				const int32 Words = ExpandBitBrick(Brick);
+				for (int32 Z = RangeMin.Z; Z <= RangeMax.Z; ++Z)
+				{
+					for (int32 Y = RangeMin.Y; Y <= RangeMax.Y; ++Y)
+					{
+						for (int32 X = RangeMin.X; X <= RangeMax.X; ++X)
+						{
+							const int32 Local = ((Z & BrickMask) << (2 * BrickShift)) | ((Y & BrickMask) << BrickShift) | (X & BrickMask);
+							const uint64 Mask = uint64(1) << (Local & 63);
+							if (bBlocked)
+							{
+								BrickBits[Words + (Local >> 6)] |= Mask;
+							}
+							else
+							{
+								BrickBits[Words + (Local >> 6)] &= ~Mask;
+							}
+						}
+					}
+				}
+				CollapseBitBrick(Brick, BrickMin, BrickMax);
+			}
+		}
+	}
+}
+
+void FNavGrid::BuildClearance(int32 InMaxClearance)
+{
+	MaxClearance = FMath::Clamp(InMaxClearance, 1, 255);
+	if (bBrickStorage)
+	{
+		// Start with every brick at clearance 0; RecomputeClearance rewrites all of them
+		BrickClearanceOffsets.Init(-1, BrickBitOffsets.Num());
+		BrickClearance.Reset();
+		FreeClearanceBlocks.Reset();
+	}
+	else
+	{
+		Clearance.SetNumUninitialized(NumCells);
+	}
+	RecomputeClearance(FIntVector::ZeroValue, GetSize() - FIntVector(1, 1, 1));
+}
+
+void FNavGrid::UpdateClearance(const FIntVector& DirtyMin, const FIntVector& DirtyMax)
+{
+	if (!HasClearanceLayer())
+	{
+		return;
+	}
+
+	// A blocked-bit change can only affect cells within MaxClearance of it
+	const FIntVector Pad(MaxClearance, MaxClearance, MaxClearance);
+	const FIntVector LastCell = GetSize() - FIntVector(1, 1, 1);
+	const FIntVector Min(
+		FMath::Max(DirtyMin.X - Pad.X, 0),
+		FMath::Max(DirtyMin.Y - Pad.Y, 0),
+		FMath::Max(DirtyMin.Z - Pad.Z, 0));
+	const FIntVector Max(
+		FMath::Min(DirtyMax.X + Pad.X, LastCell.X),
+		FMath::Min(DirtyMax.Y + Pad.Y, LastCell.Y),
+		FMath::Min(DirtyMax.Z + Pad.Z, LastCell.Z));
+
+	RecomputeClearance(Min, Max);
+}
+
+void FNavGrid::RecomputeClearance(const FIntVector& Min, const FIntVector& Max)
+{
+	if (bBrickStorage)
+	{
+		UpdateClearanceBricks(Min, Max);
+		return;
+	}
+
+	TArray<uint8> Values;
+	ComputeClearanceRegion(Min, Max, Values);
+
+	int32 ValueIndex = 0;
+	for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			const int32 RowStart = GetIndex(FIntVector(0, Y, Z));
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				Clearance[RowStart + X] = Values[ValueIndex++];
+			}
+		}
+	}
+}
+
+int32 FNavGrid::GetRequiredClearance(float AgentRadius, float AgentHalfHeight) const
+{
+	const float AgentExtent = FMath::Max(AgentRadius, AgentHalfHeight);
+	const int32 Required = FMath::CeilToInt(AgentExtent * InvCellSize + 0.5f);
+	return FMath::Clamp(Required, 1, MaxClearance);
+}
+
+void FNavGrid::ComputeClearanceRegion(const FIntVector& Min, const FIntVector& Max, TArray<uint8>& OutValues) const
+{
+	// The Chebyshev distance transform is separable: the distance along X is computed from the
+	// blocked bits, then folded with Y and finally Z via d = min over |k| <= Cap of max(|k|, d'(k)).
+	// Each pass needs its input padded by Cap cells along the axes still to be processed.
+	const int32 Cap = MaxClearance;
+	const FIntVector LastCell = GetSize() - FIntVector(1, 1, 1);
+
+	// Box A: output region padded in Y and Z (input of the Y pass)
+	const FIntVector AMin(Min.X, FMath::Max(Min.Y - Cap, 0), FMath::Max(Min.Z - Cap, 0));
+	const FIntVector AMax(Max.X, FMath::Min(Max.Y + Cap, LastCell.Y), FMath::Min(Max.Z + Cap, LastCell.Z));
+	const FIntVector ASize = AMax - AMin + FIntVector(1, 1, 1);
+
+	// Box B: output region padded in Z (input of the Z pass)
+	const FIntVector BMin(Min.X, Min.Y, AMin.Z);
+	const FIntVector BMax(Max.X, Max.Y, AMax.Z);
+	const FIntVector BSize = BMax - BMin + FIntVector(1, 1, 1);
+
+	auto LocalIndex = [](const FIntVector& Local, const FIntVector& Size)
+		{
+			return (Local.Z * Size.X * Size.Y) + (Local.Y * Size.X) + Local.X;
+		};
+
+	// Pass X: distance to the nearest blocked cell in the same row
+	TArray<uint8> DistX;
+	DistX.SetNumUninitialized(ASize.X * ASize.Y * ASize.Z);
+	for (int32 Z = AMin.Z; Z <= AMax.Z; ++Z)
+	{
+		for (int32 Y = AMin.Y; Y <= AMax.Y; ++Y)
+		{
+			const int32 RowStart = GetIndex(FIntVector(0, Y, Z));
+			for (int32 X = AMin.X; X <= AMax.X; ++X)
+			{
+				int32 Best = Cap;
+				for (int32 K = 0; K < Best; ++K)
+				{
+					if ((X - K >= 0 && IsBlocked(RowStart + X - K)) ||
+						(X + K <= LastCell.X && IsBlocked(RowStart + X + K)))
+					{
+						Best = K;
+						break;
+					}
+				}
+				DistX[LocalIndex(FIntVector(X, Y, Z) - AMin, ASize)] = static_cast<uint8>(Best);
+			}
+		}
+	}
+
+	// Pass Y: fold in the Y axis
+	TArray<uint8> DistXY;
+	DistXY.SetNumUninitialized(BSize.X * BSize.Y * BSize.Z);
+	for (int32 Z = BMin.Z; Z <= BMax.Z; ++Z)
+	{
+		for (int32 Y = BMin.Y; Y <= BMax.Y; ++Y)
+		{
+			for (int32 X = BMin.X; X <= BMax.X; ++X)
+			{
+				int32 Best = Cap;
+				for (int32 K = FMath::Max(-Cap + 1, AMin.Y - Y); K <= FMath::Min(Cap - 1, AMax.Y - Y); ++K)
+				{
+					const int32 Candidate = FMath::Max(FMath::Abs(K), static_cast<int32>(DistX[LocalIndex(FIntVector(X, Y + K, Z) - AMin, ASize)]));
+					Best = FMath::Min(Best, Candidate);
+				}
+				DistXY[LocalIndex(FIntVector(X, Y, Z) - BMin, BSize)] = static_cast<uint8>(Best);
+			}
+		}
+	}
+
+	// Pass Z: fold in the Z axis and write the final values
+	const FIntVector OutSize = Max - Min + FIntVector(1, 1, 1);
+	OutValues.SetNumUninitialized(OutSize.X * OutSize.Y * OutSize.Z);
+	for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				int32 Best = Cap;
+				for (int32 K = FMath::Max(-Cap + 1, BMin.Z - Z); K <= FMath::Min(Cap - 1, BMax.Z - Z); ++K)
+				{
+					const int32 Candidate = FMath::Max(FMath::Abs(K), static_cast<int32>(DistXY[LocalIndex(FIntVector(X, Y, Z + K) - BMin, BSize)]));
+					Best = FMath::Min(Best, Candidate);
+				}
+				OutValues[LocalIndex(FIntVector(X, Y, Z) - Min, OutSize)] = static_cast<uint8>(Best);
+			}
+		}
+	}
+}
+
+void FNavGrid::Reset()
+{
+	SizeX = SizeY = SizeZ = 0;
+	NumCells = 0;
+	BlockedBits.Empty();
+	Clearance.Empty();
+	Neighbours.Empty();
+
+	bBrickStorage = false;
+	NumBricksX = NumBricksY = NumBricksZ = 0;
+	BrickBitOffsets.Empty();
+	BrickBits.Empty();
+	FreeBitBlocks.Empty();
+	BrickClearanceOffsets.Empty();
+	BrickClearance.Empty();
+	FreeClearanceBlocks.Empty();
+}
+
+SIZE_T FNavGrid::GetAllocatedSize() const
+{
+	return BlockedBits.GetAllocatedSize()
+		+ Clearance.GetAllocatedSize()
+		+ Neighbours.GetAllocatedSize()
+		+ BrickBitOffsets.GetAllocatedSize()
+		+ BrickBits.GetAllocatedSize()
+		+ FreeBitBlocks.GetAllocatedSize()
+		+ BrickClearanceOffsets.GetAllocatedSize()
+		+ BrickClearance.GetAllocatedSize()
+		+ FreeClearanceBlocks.GetAllocatedSize();
+}
+
+void FNavGrid::Serialize(FArchive& Ar)
+{
+	Ar.UsingCustomVersion(FNavBakedDataVersion::GUID);
+	if (Ar.IsLoading())
+	{
+		Reset();
+	}
+
+	Ar << SizeX << SizeY << SizeZ;
+	Ar << MinSharedNeighborAxes;
+	Ar << Origin;
+	Ar << CellSize;
+	Ar << MaxClearance;
+	if (Ar.CustomVer(FNavBakedDataVersion::GUID) >= FNavBakedDataVersion::BrickStorage)
+	{
+		Ar << bBrickStorage;
+	}
+
+	if (bBrickStorage)
+	{
+		BrickBitOffsets.BulkSerialize(Ar);
+		BrickBits.BulkSerialize(Ar);
+		FreeBitBlocks.BulkSerialize(Ar);
+		BrickClearanceOffsets.BulkSerialize(Ar);
+		BrickClearance.BulkSerialize(Ar);
+		FreeClearanceBlocks.BulkSerialize(Ar);
+	}
+	else
+	{
+		BlockedBits.BulkSerialize(Ar);
+		Clearance.BulkSerialize(Ar);
+	}
+
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	// Derived state is not stored: recompute it, after checking the arrays fit the stored size
+	const int64 NumCellsLoaded = int64(SizeX) * SizeY * SizeZ;
+	bool bValid = !Ar.IsError()
+		&& SizeX > 0 && SizeY > 0 && SizeZ > 0 && NumCellsLoaded <= MAX_int32
+		&& CellSize > 0.0f;
+
+	if (bValid && bBrickStorage)
+	{
+		NumBricksX = (SizeX + BrickMask) >> BrickShift;
+		NumBricksY = (SizeY + BrickMask) >> BrickShift;
+		NumBricksZ = (SizeZ + BrickMask) >> BrickShift;
+		const int32 NumBricks = NumBricksX * NumBricksY * NumBricksZ;
+
+		// Every offset must address a whole block of its pool
+		auto IsValidBlock = [](int32 Offset, int32 BlockSize, int32 PoolSize)
+			{
+				return Offset >= 0 && Offset % BlockSize == 0 && Offset + BlockSize <= PoolSize;
+			};
+
+		bValid = BrickBitOffsets.Num() == NumBricks
+			&& BrickBits.Num() % WordsPerBrick == 0
+			&& (BrickClearanceOffsets.Num() == 0 || BrickClearanceOffsets.Num() == NumBricks)
+			&& BrickClearance.Num() % CellsPerBrick == 0;
+		for (int32 Brick = 0; bValid && Brick < BrickBitOffsets.Num(); ++Brick)
+		{
+			const int32 Offset = BrickBitOffsets[Brick];
+			bValid = Offset == UniformFreeBrick || Offset == UniformBlockedBrick || IsValidBlock(Offset, WordsPerBrick, BrickBits.Num());
+		}
+		for (int32 Brick = 0; bValid && Brick < BrickClearanceOffsets.Num(); ++Brick)
+		{
+			const int32 Offset = BrickClearanceOffsets[Brick];
+			bValid = (Offset < 0 && Offset >= -256) || IsValidBlock(Offset, CellsPerBrick, BrickClearance.Num());
+		}
+		for (int32 Index = 0; bValid && Index < FreeBitBlocks.Num(); ++Index)
+		{
+			bValid = IsValidBlock(FreeBitBlocks[Index], WordsPerBrick, BrickBits.Num());
+		}
+		for (int32 Index = 0; bValid && Index < FreeClearanceBlocks.Num(); ++Index)
+		{
+			bValid = IsValidBlock(FreeClearanceBlocks[Index], CellsPerBrick, BrickClearance.Num());
+		}
+	}
+	else if (bValid)
+	{
+		bValid = BlockedBits.Num() == (NumCellsLoaded + 63) / 64
+			&& (Clearance.Num() == 0 || Clearance.Num() == NumCellsLoaded);
+	}
+
+	if (!bValid)
+	{
+		Ar.SetError();
+		Reset();
+		return;
+	}
+
+	NumCells = static_cast<int32>(NumCellsLoaded);
+	InvCellSize = 1.0f / CellSize;
+	CellCenterOrigin = Origin + FVector(CellSize * 0.5f);
+	BuildNeighbourOffsets();
+}
+
+void FNavGrid::GetBrickCellRange(int32 BrickX, int32 BrickY, int32 BrickZ, FIntVector& OutMin, FIntVector& OutMax) const
+{
+	OutMin = FIntVector(BrickX << BrickShift, BrickY << BrickShift, BrickZ << BrickShift);
+	OutMax = FIntVector(
+		FMath::Min(OutMin.X + BrickMask, SizeX - 1),
+		FMath::Min(OutMin.Y + BrickMask, SizeY - 1),
+		FMath::Min(OutMin.Z + BrickMask, SizeZ - 1));
+}
+
+void FNavGrid::SetBlockedInBrick(int32 Index, bool bBlocked)
+{
+	int32 Local;
+	const int32 Brick = GetBrick(Index, Local);
+	if (BrickBitOffsets[Brick] == (bBlocked ? UniformBlockedBrick : UniformFreeBrick))
+	{
+		return;
+	}
+
+	const int32 Words = ExpandBitBrick(Brick);
+	const uint64 Mask = uint64(1) << (Local & 63);
+	if (bBlocked)
+	{
+		BrickBits[Words + (Local >> 6)] |= Mask;
+	}
+	else
+	{
+		BrickBits[Words + (Local >> 6)] &= ~Mask;
+	}
+}
+
+int32 FNavGrid::ExpandBitBrick(int32 Brick)
+{
+	const int32 Offset = BrickBitOffsets[Brick];
+	if (Offset >= 0)
+	{
+		return Offset;
+	}
+
+	const int32 Words = FreeBitBlocks.Num() > 0 ? FreeBitBlocks.Pop(EAllowShrinking::No) : BrickBits.AddUninitialized(WordsPerBrick);
+	const uint64 Fill = (Offset == UniformBlockedBrick) ? ~uint64(0) : uint64(0);
+	for (int32 Word = 0; Word < WordsPerBrick; ++Word)
+	{
+		BrickBits[Words + Word] = Fill;
+	}
+	BrickBitOffsets[Brick] = Words;
+	return Words;
+}
+
+void FNavGrid::CollapseBitBrick(int32 Brick, const FIntVector& CellMin, const FIntVector& CellMax)
+{
+	const int32 Words = BrickBitOffsets[Brick];
+	if (Words < 0)
+	{
+		return;
+	}
+
+	// Only the cells inside the grid count: edge bricks keep stale bits past the grid bounds
+	auto IsBitSet = [this, Words](int32 X, int32 Y, int32 Z)
+		{
+			const int32 Local = ((Z & BrickMask) << (2 * BrickShift)) | ((Y & BrickMask) << BrickShift) | (X & BrickMask);
+			return ((BrickBits[Words + (Local >> 6)] >> (Local & 63)) & 1) != 0;
+		};
+
+	const bool bFirst = IsBitSet(CellMin.X, CellMin.Y, CellMin.Z);
+	for (int32 Z = CellMin.Z; Z <= CellMax.Z; ++Z)
+	{
+		for (int32 Y = CellMin.Y; Y <= CellMax.Y; ++Y)
+		{
+			for (int32 X = CellMin.X; X <= CellMax.X; ++X)
+			{
+				if (IsBitSet(X, Y, Z) != bFirst)
+				{
+					return;
+				}
+			}
+		}
+	}
+
+	FreeBitBlocks.Add(Words);
+	BrickBitOffsets[Brick] = bFirst ? UniformBlockedBrick : UniformFreeBrick;
+}
+
+void FNavGrid::UpdateClearanceBricks(const FIntVector& Min, const FIntVector& Max)
+{
+	const int32 Cap = MaxClearance;
+	const FIntVector LastCell = GetSize() - FIntVector(1, 1, 1);
+	TArray<uint8> Values;
+
+	for (int32 BrickZ = Min.Z >> BrickShift; BrickZ <= Max.Z >> BrickShift; ++BrickZ)
+	{
+		for (int32 BrickY = Min.Y >> BrickShift; BrickY <= Max.Y >> BrickShift; ++BrickY)
+		{
+			for (int32 BrickX = Min.X >> BrickShift; BrickX <= Max.X >> BrickShift; ++BrickX)
+			{
+				const int32 Brick = (BrickZ * NumBricksY + BrickY) * NumBricksX + BrickX;
+				FIntVector CellMin, CellMax;
+				GetBrickCellRange(BrickX, BrickY, BrickZ, CellMin, CellMax);
+
+				// Uniform results without a distance transform: an all-blocked brick has clearance 0,
+				// and a brick with no blocked cell within Cap - 1 cells has clearance Cap everywhere
+				int32 UniformValue = INDEX_NONE;
+				if (BrickBitOffsets[Brick] == UniformBlockedBrick)
+				{
+					UniformValue = 0;
+				}
+				else
+				{
+					const FIntVector NearMin(
+						FMath::Max(CellMin.X - Cap + 1, 0) >> BrickShift,
+						FMath::Max(CellMin.Y - Cap + 1, 0) >> BrickShift,
+						FMath::Max(CellMin.Z - Cap + 1, 0) >> BrickShift);
+					const FIntVector NearMax(
+						FMath::Min(CellMax.X + Cap - 1, LastCell.X) >> BrickShift,
+						FMath::Min(CellMax.Y + Cap - 1, LastCell.Y) >> BrickShift,
+						FMath::Min(CellMax.Z + Cap - 1, LastCell.Z) >> BrickShift);
+
+					bool bNeighbourhoodFree = true;
+					for (int32 Z = NearMin.Z; bNeighbourhoodFree && Z <= NearMax.Z; ++Z)
+					{
+						for (int32 Y = NearMin.Y; bNeighbourhoodFree && Y <= NearMax.Y; ++Y)
+						{
+							for (int32 X = NearMin.X; bNeighbourhoodFree && X <= NearMax.X; ++X)
+							{
+								bNeighbourhoodFree = BrickBitOffsets[(Z * NumBricksY + Y) * NumBricksX + X] == UniformFreeBrick;
+							}
+						}
+					}
+					if (bNeighbourhoodFree)
+					{
+						UniformValue = Cap;
+					}
+				}
+
+				if (UniformValue == INDEX_NONE)
+				{
+					ComputeClearanceRegion(CellMin, CellMax, Values);
+					UniformValue = Values[0];
+					for (const uint8 Value : Values)
+					{
+						if (Value != UniformValue)
+						{
+							UniformValue = INDEX_NONE;
+							break;
+						}
+					}
+				}
+
+				int32 Offset = BrickClearanceOffsets[Brick];
+				if (UniformValue != INDEX_NONE)
+				{
+					if (Offset >= 0)
+					{
+						FreeClearanceBlocks.Add(Offset);
+					}
+					BrickClearanceOffsets[Brick] = -1 - UniformValue;
+					continue;
+				}
+
+				if (Offset < 0)
+				{
+					Offset = FreeClearanceBlocks.Num() > 0 ? FreeClearanceBlocks.Pop(EAllowShrinking::No) : BrickClearance.AddZeroed(CellsPerBrick);
+					BrickClearanceOffsets[Brick] = Offset;
+				}
+
+				// Values are in range order; the brick block uses the full brick stride
+				int32 ValueIndex = 0;
+				for (int32 Z = CellMin.Z; Z <= CellMax.Z; ++Z)
+				{
+					for (int32 Y = CellMin.Y; Y <= CellMax.Y; ++Y)
+					{
+						for (int32 X = CellMin.X; X <= CellMax.X; ++X)
+						{
+							const int32 Local = ((Z & BrickMask) << (2 * BrickShift)) | ((Y & BrickMask) << BrickShift) | (X & BrickMask);
+							BrickClearance[Offset + Local] = Values[ValueIndex++];
+						}
+					}
+				}
+			}
+		}
+	}
+}
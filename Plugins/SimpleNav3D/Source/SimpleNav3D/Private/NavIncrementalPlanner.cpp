@@ -0,0 +1,370 @@
+#include "NavIncrementalPlanner.h"
+#include "NavGrid.h"
+#include "NavOccupancyLayer.h"
+
+void FNavIncrementalPlanner::Init(int32 InRequiredClearance)
+{
+	RequiredClearance = InRequiredClearance;
+	GoalCell = INDEX_NONE;
+	ChangedRanges.Reset();
+	PathNodes.Reset();
+}
+
+void FNavIncrementalPlanner::Reset()
+{
+	Nodes.Empty();
+	Open.Empty();
+	ChangedRanges.Empty();
+	PathNodes.Empty();
+	NumOpenCells = 0;
+	GoalCell = INDEX_NONE;
+	StartCell = INDEX_NONE;
+	KeyModifier = 0.0f;
+	NumExpandedLastPlan = 0;
+}
+
+void FNavIncrementalPlanner::NotifyCellsChanged(const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	// Without a tree there is nothing to repair; the next Plan starts fresh anyway
+	if (GoalCell == INDEX_NONE)
+	{
+		return;
+	}
+
+	// An agent that stopped replanning would queue every change of the level; drop its tree instead
+	if (ChangedRanges.Num() >= MaxChangedRanges)
+	{
+		GoalCell = INDEX_NONE;
+		ChangedRanges.Reset();
+		return;
+	}
+	ChangedRanges.Emplace(MinCell, MaxCell);
+}
+
+bool FNavIncrementalPlanner::Plan(const FNavGrid& InGrid, const FNavOccupancyLayer* InOccupancy, int32 InStartCell, int32 InGoalCell, int32 InIgnoredObstacleSlot /*= INDEX_NONE*/)
+{
+	const int32 NumCells = InGrid.GetNumCells();
+	checkf(InStartCell >= 0 && InStartCell < NumCells && InGoalCell >= 0 && InGoalCell < NumCells,
+		TEXT("FNavIncrementalPlanner: start %d or goal %d outside the grid"), InStartCell, InGoalCell);
+
+	Grid = &InGrid;
+	Occupancy = InOccupancy;
+	NumExpandedLastPlan = 0;
+
+	// -------------------------------------------------------
+	// Restart when there is no tree for this grid and agent, or when the goal jumped so far
+	// (relative to the agent's distance from it) that most of the tree would be repaired anyway
+	// -------------------------------------------------------
+	const FVector NewStartCoordinates(InGrid.GetCoordinates(InStartCell));
+	bool bRestart = GoalCell == INDEX_NONE || !Nodes.IsLayoutFor(NumCells, InGrid.GetSearchPagedSize()) || InIgnoredObstacleSlot != IgnoredObstacleSlot;
+	if (!bRestart && InGoalCell != GoalCell)
+	{
+		const FVector OldGoalCoordinates(InGrid.GetCoordinates(GoalCell));
+		bRestart = FVector::Distance(FVector(InGrid.GetCoordinates(InGoalCell)), OldGoalCoordinates) * 2.0f
+			> FVector::Distance(NewStartCoordinates, OldGoalCoordinates);
+	}
+
+	IgnoredObstacleSlot = InIgnoredObstacleSlot;
+	bLastPlanRestarted = bRestart;
+
+	if (bRestart)
+	{
+		StartCell = InStartCell;
+		StartCoordinates = NewStartCoordinates;
+		BeginSearch(NumCells, InGrid.GetSearchPagedSize(), InGoalCell);
+	}
+	else
+	{
+		// The agent moved: keys queued from now on are measured from the new start. Raising them all
+		// by the distance moved keeps the old entries valid lower bounds, so the queue is not re-keyed
+		if (InStartCell != StartCell)
+		{
+			KeyModifier += FVector::Distance(StartCoordinates, NewStartCoordinates);
+			StartCell = InStartCell;
+			StartCoordinates = NewStartCoordinates;
+		}
+
+		// Changed cells, and the cells next to them whose cost went through them
+		const FIntVector Size = InGrid.GetSize();
+		for (const TPair<FIntVector, FIntVector>& Range : ChangedRanges)
+		{
+			const FIntVector Min(FMath::Max(Range.Key.X - 1, 0), FMath::Max(Range.Key.Y - 1, 0), FMath::Max(Range.Key.Z - 1, 0));
+			const FIntVector Max(FMath::Min(Range.Value.X + 1, Size.X - 1), FMath::Min(Range.Value.Y + 1, Size.Y - 1), FMath::Min(Range.Value.Z + 1, Size.Z - 1));
+			for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+			{
+				for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+				{
+					for (int32 X = Min.X; X <= Max.X; ++X)
+					{
+						UpdateCell(InGrid.GetIndex(FIntVector(X, Y, Z)));
+					}
+				}
+			}
+		}
+		ChangedRanges.Reset();
+
+		// The goal moved a little: it is the only cell with a fixed cost, so moving it is a cost change
+		// of the old goal (now costs what its neighbours say) and the new one (now costs nothing)
+		if (InGoalCell != GoalCell)
+		{
+			const int32 OldGoalCell = GoalCell;
+			GoalCell = InGoalCell;
+			UpdateCell(OldGoalCell);
+			UpdateCell(GoalCell);
+		}
+	}
+
+	ComputeShortestPath();
+	const bool bFound = ExtractPath();
+
+	Grid = nullptr;
+	Occupancy = nullptr;
+	return bFound;
+}
+
+void FNavIncrementalPlanner::BeginSearch(int32 NumCells, const FIntVector& PagedSize, int32 InGoalCell)
+{
+	Nodes.Reset(NumCells, PagedSize);
+
+	++Generation;
+	if (Generation == 0)
+	{
+		// Generation counter wrapped around: stale stamps could alias, so clear them once.
+		Nodes.ForEachElement([](FNode& Node)
+			{
+				Node.Generation = 0;
+			});
+		Generation = 1;
+	}
+
+	Open.Reset();
+	NumOpenCells = 0;
+	ChangedRanges.Reset();
+	KeyModifier = 0.0f;
+
+	GoalCell = InGoalCell;
+	FNode& Goal = Touch(GoalCell);
+	Goal.RHS = 0.0f;
+	UpdateQueue(GoalCell, Goal);
+}
+
+FNavIncrementalPlanner::FNode& FNavIncrementalPlanner::Touch(int32 Cell)
+{
+	FNode& Node = Nodes[Cell];
+	if (Node.Generation != Generation)
+	{
+		Node.G = MAX_flt;
+		Node.RHS = MAX_flt;
+		Node.bOpen = false;
+		Node.Generation = Generation;
+	}
+	return Node;
+}
+
+bool FNavIncrementalPlanner::IsFree(int32 Cell) const
+{
+	return Grid->IsPassable(Cell, RequiredClearance)
+		&& !(Occupancy && Occupancy->IsOccupiedAround(Cell, RequiredClearance, IgnoredObstacleSlot));
+}
+
+float FNavIncrementalPlanner::GetHeuristic(int32 Cell) const
+{
+	return FVector::Distance(FVector(Grid->GetCoordinates(Cell)), StartCoordinates);
+}
+
+void FNavIncrementalPlanner::UpdateCell(int32 Cell)
+{
+	FNode& Node = Touch(Cell);
+	if (Cell == GoalCell)
+	{
+		Node.RHS = 0.0f;
+	}
+	else
+	{
+		// Search edges point toward the goal: entering a neighbour costs the move, if the agent may enter it
+		float BestCost = MAX_flt;
+		Grid->ForEachNeighbour(Cell, [this, &BestCost](int32 Neighbour, float EdgeCost)
+			{
+				const float NeighbourG = GetG(Neighbour);
+				if (NeighbourG < MAX_flt && NeighbourG + EdgeCost < BestCost && IsFree(Neighbour))
+				{
+					BestCost = NeighbourG + EdgeCost;
+				}
+			});
+		Node.RHS = BestCost;
+	}
+	UpdateQueue(Cell, Node);
+}
+
+void FNavIncrementalPlanner::UpdateQueue(int32 Cell, FNode& Node)
+{
+	if (Node.G == Node.RHS)
+	{
+		if (Node.bOpen)
+		{
+			Node.bOpen = false;
+			--NumOpenCells;
+		}
+		return;
+	}
+
+	const float MinCost = FMath::Min(Node.G, Node.RHS);
+	const float Key1 = MinCost + GetHeuristic(Cell) + KeyModifier;
+	if (Node.bOpen && Node.Key1 == Key1 && Node.Key2 == MinCost)
+	{
+		return;
+	}
+
+	if (!Node.bOpen)
+	{
+		Node.bOpen = true;
+		++NumOpenCells;
+	}
+	Node.Key1 = Key1;
+	Node.Key2 = MinCost;
+	Open.HeapPush(FOpenEntry{ Key1, MinCost, Cell }, FOpenEntryLess());
+
+	// Re-keyed cells leave stale entries behind; rebuild the heap from the live ones once they dominate
+	if (Open.Num() > 4 * NumOpenCells + 1024)
+	{
+		Open.RemoveAll([this](const FOpenEntry& Entry)
+			{
+				const FNode& EntryNode = Nodes[Entry.Cell];
+				return EntryNode.Generation != Generation || !EntryNode.bOpen || EntryNode.Key1 != Entry.Key1 || EntryNode.Key2 != Entry.Key2;
+			});
+		Open.Heapify(FOpenEntryLess());
+	}
+}
+
+void FNavIncrementalPlanner::PruneQueueTop()
+{
+	while (Open.Num() > 0)
+	{
+		const FOpenEntry& Top = Open.HeapTop();
+		const FNode& Node = Nodes[Top.Cell];
+		if (Node.Generation == Generation && Node.bOpen && Node.Key1 == Top.Key1 && Node.Key2 == Top.Key2)
+		{
+			return;
+		}
+		Open.HeapPopDiscard(FOpenEntryLess(), EAllowShrinking::No);
+	}
+}
+
+void FNavIncrementalPlanner::ComputeShortestPath()
+{
+	const FOpenEntryLess KeyLess;
+	while (true)
+	{
+		PruneQueueTop();
+		if (Open.Num() == 0)
+		{
+			break;
+		}
+
+		// Done once the start is consistent and no queued cell could still lower its cost
+		const FOpenEntry Top = Open.HeapTop();
+		const FNode& Start = Touch(StartCell);
+		const float StartKey = FMath::Min(Start.G, Start.RHS) + KeyModifier;
+		if (Top.Key1 > StartKey + StartKey * KeyTolerance && Start.G == Start.RHS)
+		{
+			break;
+		}
+
+		Open.HeapPopDiscard(KeyLess, EAllowShrinking::No);
+		FNode& Node = Nodes[Top.Cell];
+		++NumExpandedLastPlan;
+
+		// Queued before the agent last moved: its key is only a lower bound, queue it again with the real one
+		const float MinCost = FMath::Min(Node.G, Node.RHS);
+		if (KeyLess(Top, FOpenEntry{ MinCost + GetHeuristic(Top.Cell) + KeyModifier, MinCost, Top.Cell }))
+		{
+			Node.bOpen = false;
+			--NumOpenCells;
+			UpdateQueue(Top.Cell, Node);
+			continue;
+		}
+
+		// Nothing enters a cell the agent cannot enter, so its cost does not propagate
+		const bool bFree = IsFree(Top.Cell);
+		if (Node.G > Node.RHS)
+		{
+			// Cost went down: settle it and offer it to the neighbours
+			Node.G = Node.RHS;
+			Node.bOpen = false;
+			--NumOpenCells;
+
+			if (bFree)
+			{
+				const float CellCost = Node.G;
+				Grid->ForEachNeighbour(Top.Cell, [this, CellCost](int32 Neighbour, float EdgeCost)
+					{
+						FNode& NeighbourNode = Touch(Neighbour);
+						if (Neighbour != GoalCell && CellCost + EdgeCost < NeighbourNode.RHS)
+						{
+							NeighbourNode.RHS = CellCost + EdgeCost;
+							UpdateQueue(Neighbour, NeighbourNode);
+						}
+					});
+			}
+		}
+		else
+		{
+			// Cost went up: forget it, and recompute the neighbours whose best move went through it
+			const float OldCost = Node.G;
+			Node.G = MAX_flt;
+			UpdateCell(Top.Cell);
+
+			if (bFree)
+			{
+				Grid->ForEachNeighbour(Top.Cell, [this, OldCost](int32 Neighbour, float EdgeCost)
+					{
+						if (Neighbour != GoalCell && Touch(Neighbour).RHS == OldCost + EdgeCost)
+						{
+							UpdateCell(Neighbour);
+						}
+					});
+			}
+		}
+	}
+}
+
+bool FNavIncrementalPlanner::ExtractPath()
+{
+	PathNodes.Reset();
+	PathNodes.Add(StartCell);
+	if (StartCell == GoalCell)
+	{
+		return true;
+	}
+	if (GetG(StartCell) == MAX_flt)
+	{
+		PathNodes.Reset();
+		return false;
+	}
+
+	// Costs strictly fall toward the goal along the best moves; requiring it means a walk can never cycle
+	int32 Cell = StartCell;
+	while (Cell != GoalCell)
+	{
+		int32 BestCell = INDEX_NONE;
+		float BestCost = MAX_flt;
+		Grid->ForEachNeighbour(Cell, [this, &BestCell, &BestCost](int32 Neighbour, float EdgeCost)
+			{
+				const float NeighbourG = GetG(Neighbour);
+				if (NeighbourG < MAX_flt && NeighbourG + EdgeCost < BestCost && IsFree(Neighbour))
+				{
+					BestCell = Neighbour;
+					BestCost = NeighbourG + EdgeCost;
+				}
+			});
+
+		if (BestCell == INDEX_NONE || GetG(BestCell) >= GetG(Cell))
+		{
+			PathNodes.Reset();
+			return false;
+		}
+		PathNodes.Add(BestCell);
+		Cell = BestCell;
+	}
+	return true;
+}
@@ -0,0 +1,215 @@
+#include "NavOccupancyLayer.h"
+
+namespace NavOccupancyLayer
+{
+	/** Intersects two inclusive ranges in place. Returns false if they do not overlap. */
+	static bool IntersectRange(FIntVector& InOutMin, FIntVector& InOutMax, const FIntVector& OtherMin, const FIntVector& OtherMax)
+	{
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			InOutMin[Axis] = FMath::Max(InOutMin[Axis], OtherMin[Axis]);
+			InOutMax[Axis] = FMath::Min(InOutMax[Axis], OtherMax[Axis]);
+			if (InOutMin[Axis] > InOutMax[Axis])
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+void FNavOccupancyLayer::Init(const FIntVector& InSize)
+{
+	Reset();
+
+	Size = InSize;
+	NumCells = Size.X * Size.Y * Size.Z;
+}
+
+void FNavOccupancyLayer::Reset()
+{
+	Size = FIntVector::ZeroValue;
+	NumCells = 0;
+	Bits.Empty();
+	Obstacles.Empty();
+	FreeSlots.Empty();
+	DirtyRanges.Empty();
+	NumObstaclesWithCells = 0;
+}
+
+int32 FNavOccupancyLayer::AddObstacle()
+{
+	const int32 Slot = FreeSlots.Num() > 0 ? FreeSlots.Pop(EAllowShrinking::No) : Obstacles.AddDefaulted();
+	Obstacles[Slot] = FObstacle();
+	Obstacles[Slot].bInUse = true;
+	return Slot;
+}
+
+void FNavOccupancyLayer::RemoveObstacle(int32 Slot)
+{
+	checkf(Obstacles.IsValidIndex(Slot) && Obstacles[Slot].bInUse, TEXT("FNavOccupancyLayer: invalid obstacle slot %d"), Slot);
+
+	ClearObstacleRange(Slot);
+	Obstacles[Slot].bInUse = false;
+	FreeSlots.Add(Slot);
+}
+
+void FNavOccupancyLayer::SetObstacleRange(int32 Slot, const FIntVector& Min, const FIntVector& Max)
+{
+	FObstacle& Obstacle = Obstacles[Slot];
+	if (Obstacle.bHasCells && Obstacle.Min == Min && Obstacle.Max == Max)
+	{
+		return;
+	}
+
+	ClearObstacleRange(Slot);
+	Obstacle.Min = Min;
+	Obstacle.Max = Max;
+	Obstacle.bHasCells = true;
+	DirtyRanges.Emplace(Min, Max);
+}
+
+void FNavOccupancyLayer::ClearObstacleRange(int32 Slot)
+{
+	FObstacle& Obstacle = Obstacles[Slot];
+	if (Obstacle.bHasCells)
+	{
+		DirtyRanges.Emplace(Obstacle.Min, Obstacle.Max);
+		Obstacle.bHasCells = false;
+	}
+}
+
+bool FNavOccupancyLayer::Flush()
+{
+	using namespace NavOccupancyLayer;
+
+	if (DirtyRanges.Num() == 0)
+	{
+		return false;
+	}
+
+	// Cells of a changed range may still be covered by other obstacles:
+	// clear the ranges, then stamp back every obstacle's share of them
+	for (const TPair<FIntVector, FIntVector>& Range : DirtyRanges)
+	{
+		SetRangeBits(Range.Key, Range.Value, false);
+	}
+
+	NumObstaclesWithCells = 0;
+	for (const FObstacle& Obstacle : Obstacles)
+	{
+		if (!Obstacle.bInUse || !Obstacle.bHasCells)
+		{
+			continue;
+		}
+
+		++NumObstaclesWithCells;
+		for (const TPair<FIntVector, FIntVector>& Range : DirtyRanges)
+		{
+			FIntVector Min = Obstacle.Min;
+			FIntVector Max = Obstacle.Max;
+			if (IntersectRange(Min, Max, Range.Key, Range.Value))
+			{
+				SetRangeBits(Min, Max, true);
+			}
+		}
+	}
+
+	DirtyRanges.Reset();
+	return true;
+}
+
+bool FNavOccupancyLayer::IsOccupied(int32 Index, int32 IgnoredSlot) const
+{
+	if (!IsOccupied(Index))
+	{
+		return false;
+	}
+
+	if (IgnoredSlot == INDEX_NONE)
+	{
+		return true;
+	}
+
+	// Occupied bit set: free for the querying agent only if its own obstacle is the sole cover
+	const FIntVector Cell = GetCoordinates(Index);
+
+	for (int32 Slot = 0; Slot < Obstacles.Num(); ++Slot)
+	{
+		const FObstacle& Obstacle = Obstacles[Slot];
+		if (Slot != IgnoredSlot && Obstacle.bInUse && Obstacle.bHasCells
+			&& Cell.X >= Obstacle.Min.X && Cell.X <= Obstacle.Max.X
+			&& Cell.Y >= Obstacle.Min.Y && Cell.Y <= Obstacle.Max.Y
+			&& Cell.Z >= Obstacle.Min.Z && Cell.Z <= Obstacle.Max.Z)
+		{
+			return true;
+		}
+	}
+	return false;
+}
+
+bool FNavOccupancyLayer::IsRangeOccupied(const FIntVector& Min, const FIntVector& Max, int32 IgnoredSlot) const
+{
+	for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			const int32 RowStart = (Z * Size.Y + Y) * Size.X;
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				if (IsOccupied(RowStart + X, IgnoredSlot))
+				{
+					return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+bool FNavOccupancyLayer::IsOccupiedAround(int32 Index, int32 RequiredClearance, int32 IgnoredSlot) const
+{
+	if (RequiredClearance <= 1 || Bits.Num() == 0)
+	{
+		return IsOccupied(Index, IgnoredSlot);
+	}
+
+	const FIntVector Cell = GetCoordinates(Index);
+	const int32 Reach = RequiredClearance - 1;
+	const FIntVector Min(FMath::Max(Cell.X - Reach, 0), FMath::Max(Cell.Y - Reach, 0), FMath::Max(Cell.Z - Reach, 0));
+	const FIntVector Max(FMath::Min(Cell.X + Reach, Size.X - 1), FMath::Min(Cell.Y + Reach, Size.Y - 1), FMath::Min(Cell.Z + Reach, Size.Z - 1));
+	return IsRangeOccupied(Min, Max, IgnoredSlot);
+}
+
+void FNavOccupancyLayer::SetRangeBits(const FIntVector& Min, const FIntVector& Max, bool bOccupied)
+{
+	if (Bits.Num() == 0)
+	{
+		if (!bOccupied)
+		{
+			return;
+		}
+		Bits.SetNumZeroed((NumCells + 63) / 64);
+	}
+
+	for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+	{
+		for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+		{
+			const int32 RowStart = (Z * Size.Y + Y) * Size.X;
+			for (int32 X = Min.X; X <= Max.X; ++X)
+			{
+				const int32 Index = RowStart + X;
+				const uint64 Mask = uint64(1) << (Index & 63);
+				if (bOccupied)
+				{
+					Bits[Index >> 6] |= Mask;
+				}
+				else
+				{
+					Bits[Index >> 6] &= ~Mask;
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,209 @@
+#include "NavOctree.h"
+
+void FNavOctree::Build(const FBox& InRootBounds, float InMinCellSize, int32 InMaxDepth, TArray<FNavOctreeLeaf>& OutLeaves)
+{
+	RootBounds = InRootBounds;
+	MinCellSize = InMinCellSize;
+	MaxDepth = InMaxDepth;
+
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+	BuildNode(0, RootBounds, 0, OutLeaves);
+}
+
+bool FNavOctree::IsLeafSize(const FBox& Bounds, int32 Depth) const
+{
+	// Leaf condition based on max side length and max depth
+	const FVector BoxSize = Bounds.GetSize();
+	const float MaxSideLength = FMath::Max3(BoxSize.X, BoxSize.Y, BoxSize.Z);
+
+	const bool bSmallEnough = (MaxSideLength <= MinCellSize + KINDA_SMALL_NUMBER);
+	const bool bMaxDepthReached = (Depth >= MaxDepth);
+
+	return bSmallEnough || bMaxDepthReached;
+}
+
+void FNavOctree::BuildNode(int32 NodeIndex, const FBox& Bounds, int32 Depth, TArray<FNavOctreeLeaf>& OutLeaves)
+{
+	if (IsLeafSize(Bounds, Depth))
+	{
+		OutLeaves.Add(FNavOctreeLeaf{ NodeIndex, Bounds });
+		return;
+	}
+
+	// Internal node: allocate the 8 children as one contiguous group.
+	// Nodes may reallocate here, so only indices are kept across the recursion.
+	const int32 FirstChild = Nodes.Num();
+	Nodes.AddDefaulted(8);
+	Nodes[NodeIndex].FirstChild = FirstChild;
+
+	for (int32 Child = 0; Child < 8; ++Child)
+	{
+		BuildNode(FirstChild + Child, GetChildBounds(Bounds, Child), Depth + 1, OutLeaves);
+	}
+}
+
+void FNavOctree::RefineRegion(const FBox& Region, TArray<FNavOctreeLeaf>& OutLeaves)
+{
+	if (Nodes.Num() > 0)
+	{
+		RefineNode(0, RootBounds, 0, Region, OutLeaves);
+	}
+}
+
+void FNavOctree::RefineNode(int32 NodeIndex, const FBox& Bounds, int32 Depth, const FBox& Region, TArray<FNavOctreeLeaf>& OutLeaves)
+{
+	if (!Bounds.Intersect(Region))
+	{
+		return;
+	}
+
+	if (Nodes[NodeIndex].IsLeaf())
+	{
+		if (IsLeafSize(Bounds, Depth))
+		{
+			OutLeaves.Add(FNavOctreeLeaf{ NodeIndex, Bounds });
+			return;
+		}
+
+		// Collapsed leaf: split it again. Appending keeps children after their parent;
+		// children outside the region keep the collapsed value, which was uniform.
+		const int32 FirstChild = Nodes.Num();
+		const bool bBlocked = Nodes[NodeIndex].bBlocked;
+		Nodes.AddDefaulted(8);
+		Nodes[NodeIndex].FirstChild = FirstChild;
+		for (int32 Child = 0; Child < 8; ++Child)
+		{
+			Nodes[FirstChild + Child].bBlocked = bBlocked;
+		}
+	}
+
+	const int32 FirstChild = Nodes[NodeIndex].FirstChild;
+	for (int32 Child = 0; Child < 8; ++Child)
+	{
+		RefineNode(FirstChild + Child, GetChildBounds(Bounds, Child), Depth + 1, Region, OutLeaves);
+	}
+}
+
+void FNavOctree::CollapseUniformSubtrees()
+{
+	if (Nodes.Num() == 0)
+	{
+		return;
+	}
+
+	// Children are always stored after their parent, so a reverse sweep
+	// visits every node after its whole subtree has been collapsed.
+	for (int32 NodeIndex = Nodes.Num() - 1; NodeIndex >= 0; --NodeIndex)
+	{
+		FNavOctreeNode& Node = Nodes[NodeIndex];
+		if (Node.IsLeaf())
+		{
+			continue;
+		}
+
+		const FNavOctreeNode& FirstChild = Nodes[Node.FirstChild];
+		bool bUniform = FirstChild.IsLeaf();
+		for (int32 Child = 1; Child < 8 && bUniform; ++Child)
+		{
+			const FNavOctreeNode& Sibling = Nodes[Node.FirstChild + Child];
+			bUniform = Sibling.IsLeaf() && Sibling.bBlocked == FirstChild.bBlocked;
+		}
+
+		if (bUniform)
+		{
+			Node.bBlocked = FirstChild.bBlocked;
+			Node.FirstChild = INDEX_NONE;
+		}
+	}
+
+	// Compact: copy the reachable nodes breadth first into a fresh arena
+	TArray<FNavOctreeNode> Compacted;
+	Compacted.Reserve(Nodes.Num());
+	Compacted.Add(Nodes[0]);
+	for (int32 NodeIndex = 0; NodeIndex < Compacted.Num(); ++NodeIndex)
+	{
+		if (Compacted[NodeIndex].IsLeaf())
+		{
+			continue;
+		}
+
+		const int32 OldFirstChild = Compacted[NodeIndex].FirstChild;
+		Compacted[NodeIndex].FirstChild = Compacted.Num();
+		for (int32 Child = 0; Child < 8; ++Child)
+		{
+			Compacted.Add(Nodes[OldFirstChild + Child]);
+		}
+	}
+
+	Compacted.Shrink();
+	Nodes = MoveTemp(Compacted);
+}
+
+void FNavOctree::Reset()
+{
+	Nodes.Empty();
+	RootBounds = FBox(ForceInit);
+}
+
+void FNavOctree::Serialize(FArchive& Ar)
+{
+	Ar << RootBounds;
+	Ar << MinCellSize;
+	Ar << MaxDepth;
+	Ar << Nodes;
+
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	// Children are stored after their parent in groups of 8; anything else would break traversal
+	bool bValid = !Ar.IsError();
+	for (int32 NodeIndex = 0; bValid && NodeIndex < Nodes.Num(); ++NodeIndex)
+	{
+		const int32 FirstChild = Nodes[NodeIndex].FirstChild;
+		bValid = FirstChild == INDEX_NONE || (FirstChild > NodeIndex && FirstChild <= Nodes.Num() - 8);
+	}
+
+	if (!bValid)
+	{
+		Ar.SetError();
+		Reset();
+	}
+}
+
+int32 FNavOctree::FindLeaf(const FVector& WorldPoint, FBox* OutBounds) const
+{
+	if (Nodes.Num() == 0 || !RootBounds.IsInsideOrOn(WorldPoint))
+	{
+		return INDEX_NONE;
+	}
+
+	// Traverse octree down to the leaf that contains WorldPoint
+	FBox Bounds = RootBounds;
+	int32 NodeIndex = 0;
+	while (!Nodes[NodeIndex].IsLeaf())
+	{
+		const FVector Center = Bounds.GetCenter();
+		const int32 ChildIndex =
+			(WorldPoint.X >= Center.X ? 1 : 0)
+			| ((WorldPoint.Y >= Center.Y ? 1 : 0) << 1)
+			| ((WorldPoint.Z >= Center.Z ? 1 : 0) << 2);
+
+		Bounds = GetChildBounds(Bounds, ChildIndex);
+		NodeIndex = Nodes[NodeIndex].FirstChild + ChildIndex;
+	}
+
+	if (OutBounds)
+	{
+		*OutBounds = Bounds;
+	}
+	return NodeIndex;
+}
+
+bool FNavOctree::IsPointBlocked(const FVector& WorldPoint) const
+{
+	const int32 Leaf = FindLeaf(WorldPoint);
+	return Leaf != INDEX_NONE && Nodes[Leaf].bBlocked;
+}
@@ -0,0 +1,280 @@
+#include "NavPathCache.h"
+#include "NavGrid.h"
+
+void FNavPathCache::Init(const FIntVector& InGridSize, int32 InRegionSize, int32 InCapacity)
+{
+	Reset();
+
+	if (InGridSize.X <= 0 || InGridSize.Y <= 0 || InGridSize.Z <= 0 || InCapacity <= 0)
+	{
+		return;
+	}
+
+	GridSize = InGridSize;
+	RegionSize = FMath::Max(InRegionSize, 1);
+	NumRegions = FIntVector(
+		FMath::DivideAndRoundUp(GridSize.X, RegionSize),
+		FMath::DivideAndRoundUp(GridSize.Y, RegionSize),
+		FMath::DivideAndRoundUp(GridSize.Z, RegionSize));
+	Capacity = InCapacity;
+
+	RegionStamps.SetNumZeroed(NumRegions.X * NumRegions.Y * NumRegions.Z);
+	Entries.Reserve(Capacity);
+	EntryMap.Reserve(Capacity);
+}
+
+void FNavPathCache::Reset()
+{
+	GridSize = FIntVector::ZeroValue;
+	RegionSize = 1;
+	NumRegions = FIntVector::ZeroValue;
+	Capacity = 0;
+	RegionStamps.Empty();
+	CurrentStamp = 0;
+	Entries.Empty();
+	FreeEntries.Empty();
+	EntryMap.Empty();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+	NumHits = 0;
+	NumMisses = 0;
+}
+
+void FNavPathCache::Empty()
+{
+	// Entry slots keep their path and region arrays for reuse
+	FreeEntries.Reset();
+	for (int32 EntryIndex = Entries.Num() - 1; EntryIndex >= 0; --EntryIndex)
+	{
+		FreeEntries.Add(EntryIndex);
+	}
+	EntryMap.Reset();
+	Head = INDEX_NONE;
+	Tail = INDEX_NONE;
+}
+
+const TArray<int32>* FNavPathCache::Find(const FNavPathCacheKey& Key)
+{
+	const int32* EntryIndex = IsInitialized() ? EntryMap.Find(Key) : nullptr;
+	if (!EntryIndex)
+	{
+		++NumMisses;
+		return nullptr;
+	}
+
+	// Geometry changed along the path since it was stored
+	if (!IsEntryValid(Entries[*EntryIndex]))
+	{
+		RemoveEntry(*EntryIndex);
+		++NumMisses;
+		return nullptr;
+	}
+
+	const int32 Index = *EntryIndex;
+	if (Head != Index)
+	{
+		Unlink(Index);
+		LinkFront(Index);
+	}
+
+	++NumHits;
+	return &Entries[Index].PathNodes;
+}
+
+void FNavPathCache::Add(const FNavPathCacheKey& Key, const FNavGrid& Grid, const TArray<int32>& PathNodes)
+{
+	if (!IsInitialized() || PathNodes.Num() == 0)
+	{
+		return;
+	}
+	checkf(Grid.GetSize() == GridSize, TEXT("FNavPathCache: grid size does not match the cache"));
+
+	// Reuse the key's entry, a free slot, a new slot or the least recently used entry
+	int32 EntryIndex = INDEX_NONE;
+	if (const int32* Existing = EntryMap.Find(Key))
+	{
+		EntryIndex = *Existing;
+		Unlink(EntryIndex);
+	}
+	else
+	{
+		if (FreeEntries.Num() == 0 && Entries.Num() >= Capacity)
+		{
+			RemoveEntry(Tail);
+		}
+		EntryIndex = FreeEntries.Num() > 0 ? FreeEntries.Pop(EAllowShrinking::No) : Entries.AddDefaulted();
+		EntryMap.Add(Key, EntryIndex);
+	}
+
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Key = Key;
+	Entry.PathNodes = PathNodes;
+	Entry.Stamp = CurrentStamp;
+
+	// Regions along every segment: Theta* and smoothed paths skip the cells between waypoints.
+	// The stretch from the last cell back to the requested goal covers goal relocation.
+	Entry.Regions.Reset();
+	FIntVector Previous = Grid.GetCoordinates(PathNodes[0]);
+	AddSegmentRegions(Previous, Previous, Entry.Regions);
+	for (int32 Index = 1; Index < PathNodes.Num(); ++Index)
+	{
+		const FIntVector Current = Grid.GetCoordinates(PathNodes[Index]);
+		AddSegmentRegions(Previous, Current, Entry.Regions);
+		Previous = Current;
+	}
+	if (Key.GoalCell != PathNodes.Last())
+	{
+		AddSegmentRegions(Previous, Grid.GetCoordinates(Key.GoalCell), Entry.Regions);
+	}
+
+	Entry.Regions.Sort();
+	int32 NumUnique = 0;
+	for (int32 Index = 0; Index < Entry.Regions.Num(); ++Index)
+	{
+		if (NumUnique == 0 || Entry.Regions[NumUnique - 1] != Entry.Regions[Index])
+		{
+			Entry.Regions[NumUnique++] = Entry.Regions[Index];
+		}
+	}
+	Entry.Regions.SetNum(NumUnique, EAllowShrinking::No);
+
+	LinkFront(EntryIndex);
+}
+
+void FNavPathCache::InvalidateCells(const FIntVector& Min, const FIntVector& Max)
+{
+	if (!IsInitialized())
+	{
+		return;
+	}
+
+	FIntVector RegionMin, RegionMax;
+	for (int32 Axis = 0; Axis < 3; ++Axis)
+	{
+		const int32 CellMin = FMath::Max(Min[Axis], 0);
+		const int32 CellMax = FMath::Min(Max[Axis], GridSize[Axis] - 1);
+		if (CellMin > CellMax)
+		{
+			return;
+		}
+		RegionMin[Axis] = CellMin / RegionSize;
+		RegionMax[Axis] = CellMax / RegionSize;
+	}
+
+	++CurrentStamp;
+	for (int32 Z = RegionMin.Z; Z <= RegionMax.Z; ++Z)
+	{
+		for (int32 Y = RegionMin.Y; Y <= RegionMax.Y; ++Y)
+		{
+			for (int32 X = RegionMin.X; X <= RegionMax.X; ++X)
+			{
+				RegionStamps[X + Y * NumRegions.X + Z * NumRegions.X * NumRegions.Y] = CurrentStamp;
+			}
+		}
+	}
+}
+
+bool FNavPathCache::IsEntryValid(const FEntry& Entry) const
+{
+	for (const int32 Region : Entry.Regions)
+	{
+		if (RegionStamps[Region] > Entry.Stamp)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+void FNavPathCache::AddSegmentRegions(const FIntVector& From, const FIntVector& To, TArray<int32>& OutRegions) const
+{
+	const FIntVector Delta = To - From;
+	const int32 MaxDelta = FMath::Max3(FMath::Abs(Delta.X), FMath::Abs(Delta.Y), FMath::Abs(Delta.Z));
+
+	// Neighbouring cells: the two endpoints are all the segment touches
+	if (MaxDelta <= 1)
+	{
+		OutRegions.Add(GetRegionIndex(From));
+		if (MaxDelta == 1)
+		{
+			OutRegions.Add(GetRegionIndex(To));
+		}
+		return;
+	}
+
+	// Longer segments are sampled every half cell; each sample also claims the regions of its
+	// neighbouring cells, which covers every cell a line of sight test along the segment reads
+	const int32 NumSteps = 2 * MaxDelta;
+	for (int32 Step = 0; Step <= NumSteps; ++Step)
+	{
+		const float Alpha = float(Step) / float(NumSteps);
+		FIntVector Cell;
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			Cell[Axis] = From[Axis] + FMath::RoundToInt(Delta[Axis] * Alpha);
+		}
+
+		for (int32 Z = FMath::Max(Cell.Z - 1, 0) / RegionSize; Z <= FMath::Min(Cell.Z + 1, GridSize.Z - 1) / RegionSize; ++Z)
+		{
+			for (int32 Y = FMath::Max(Cell.Y - 1, 0) / RegionSize; Y <= FMath::Min(Cell.Y + 1, GridSize.Y - 1) / RegionSize; ++Y)
+			{
+				for (int32 X = FMath::Max(Cell.X - 1, 0) / RegionSize; X <= FMath::Min(Cell.X + 1, GridSize.X - 1) / RegionSize; ++X)
+				{
+					const int32 Region = X + Y * NumRegions.X + Z * NumRegions.X * NumRegions.Y;
+					if (OutRegions.Num() == 0 || OutRegions.Last() != Region)
+					{
+						OutRegions.Add(Region);
+					}
+				}
+			}
+		}
+	}
+}
+
+void FNavPathCache::Unlink(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	if (Entry.Prev != INDEX_NONE)
+	{
+		Entries[Entry.Prev].Next = Entry.Next;
+	}
+	else
+	{
+		Head = Entry.Next;
+	}
+
+	if (Entry.Next != INDEX_NONE)
+	{
+		Entries[Entry.Next].Prev = Entry.Prev;
+	}
+	else
+	{
+		Tail = Entry.Prev;
+	}
+
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = INDEX_NONE;
+}
+
+void FNavPathCache::LinkFront(int32 EntryIndex)
+{
+	FEntry& Entry = Entries[EntryIndex];
+	Entry.Prev = INDEX_NONE;
+	Entry.Next = Head;
+	if (Head != INDEX_NONE)
+	{
+		Entries[Head].Prev = EntryIndex;
+	}
+	Head = EntryIndex;
+	if (Tail == INDEX_NONE)
+	{
+		Tail = EntryIndex;
+	}
+}
+
+void FNavPathCache::RemoveEntry(int32 EntryIndex)
+{
+	Unlink(EntryIndex);
+	EntryMap.Remove(Entries[EntryIndex].Key);
+	FreeEntries.Add(EntryIndex);
+}
@@ -0,0 +1,252 @@
+#include "NavSlicedPathService.h"
+#include "HAL/PlatformTime.h"
+
+int32 FNavSlicedPathService::AddRequest(const FVector& InStart, const FVector& InDestination, const FNavPathQuery& Options, int32 IgnoredObstacleSlot)
+{
+	const int32 RequestId = NextRequestId++;
+
+	// Ids only need to be unique among outstanding requests; skip INDEX_NONE and 0 on wrap-around
+	if (NextRequestId <= 0)
+	{
+		NextRequestId = 1;
+	}
+
+	FRequest& Request = Queued.EmplaceLast();
+	Request.RequestId = RequestId;
+	Request.Start = InStart;
+	Request.Destination = InDestination;
+	Request.Options = Options;
+	Request.IgnoredObstacleSlot = IgnoredObstacleSlot;
+	++NumQueued;
+	return RequestId;
+}
+
+bool FNavSlicedPathService::CancelRequest(int32 RequestId)
+{
+	if (RequestId == INDEX_NONE)
+	{
+		return false;
+	}
+
+	for (int32 Index = 0; Index < Active.Num(); ++Index)
+	{
+		if (Active[Index].RequestId == RequestId)
+		{
+			FreeContexts.Add(MoveTemp(Active[Index].Context));
+			Active.RemoveAt(Index);
+			if (NextActive > Index)
+			{
+				--NextActive;
+			}
+			return true;
+		}
+	}
+
+	for (int32 Index = 0; Index < Queued.Num(); ++Index)
+	{
+		if (Queued[Index].RequestId == RequestId)
+		{
+			// Skipped when it reaches the front
+			Queued[Index].RequestId = INDEX_NONE;
+			--NumQueued;
+			return true;
+		}
+	}
+	return false;
+}
+
+void FNavSlicedPathService::Tick(const FNavGridSnapshotPtr& Snapshot, const FNavOccupancyLayer* Occupancy, double BudgetSeconds, int32 MaxExpansions, int32 MaxConcurrentSearches)
+{
+	NumExpandedLastTick = 0;
+	if (!Snapshot.IsValid() || !Snapshot->IsInitialized())
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	auto IsOverBudget = [this, StartTime, BudgetSeconds, MaxExpansions]()
+		{
+			return (MaxExpansions > 0 && NumExpandedLastTick >= MaxExpansions)
+				|| (BudgetSeconds > 0.0 && FPlatformTime::Seconds() - StartTime >= BudgetSeconds);
+		};
+
+	while (!IsOverBudget())
+	{
+		// Fill free slots from the queue; requests without a free goal fail right here
+		while (Active.Num() < MaxConcurrentSearches && !Queued.IsEmpty())
+		{
+			FRequest Request = MoveTemp(Queued.First());
+			Queued.PopFirst();
+			if (Request.RequestId == INDEX_NONE)
+			{
+				continue;
+			}
+
+			--NumQueued;
+			if (StartRequest(Request, Snapshot, Occupancy))
+			{
+				Active.Add(MoveTemp(Request));
+			}
+		}
+
+		if (Active.Num() == 0)
+		{
+			break;
+		}
+
+		// One slice for the next search in turn
+		if (NextActive >= Active.Num())
+		{
+			NextActive = 0;
+		}
+		FRequest& Request = Active[NextActive];
+
+		const int32 SliceBudget = MaxExpansions > 0 ? FMath::Min(SliceExpansions, MaxExpansions - NumExpandedLastTick) : SliceExpansions;
+		const int32 ExpandedBefore = Request.Context->NumExpanded;
+		const ENavSearchStatus Status = StepRequest(Request, Occupancy, SliceBudget);
+		NumExpandedLastTick += Request.Context->NumExpanded - ExpandedBefore;
+
+		if (Status == ENavSearchStatus::InProgress)
+		{
+			++NextActive;
+			continue;
+		}
+
+		// Keep the order of the others so the rotation stays fair
+		FinishRequest(Request, Status == ENavSearchStatus::Succeeded, Occupancy);
+		Active.RemoveAt(NextActive);
+	}
+}
+
+bool FNavSlicedPathService::PopResult(FNavAsyncPathResult& OutResult)
+{
+	return Results.Dequeue(OutResult);
+}
+
+void FNavSlicedPathService::Reset()
+{
+	Queued.Reset();
+	NumQueued = 0;
+	Active.Empty();
+	NextActive = 0;
+	FreeContexts.Empty();
+	Results.Empty();
+	NumExpandedLastTick = 0;
+}
+
+bool FNavSlicedPathService::StartRequest(FRequest& Request, const FNavGridSnapshotPtr& Snapshot, const FNavOccupancyLayer* Occupancy)
+{
+	const FNavGrid& Grid = *Snapshot;
+
+	// Convert world-space start/destination to grid cells
+	Request.Options.StartNode = Grid.GetIndex(Grid.GetClampedCoordinates(Request.Start));
+	int32 GoalNode = Grid.GetIndex(Grid.GetClampedCoordinates(Request.Destination));
+
+	// Snap goal to nearest free node if the agent does not fit there
+	const bool bUseOccupancy = Occupancy && Occupancy->HasOccupiedCells();
+	auto IsCellFree = [Occupancy, &Request](int32 Cell)
+		{
+			return !Occupancy->IsOccupiedAround(Cell, Request.Options.RequiredClearance, Request.IgnoredObstacleSlot);
+		};
+
+	const int32 RequiredClearance = Request.Options.RequiredClearance;
+	if (!Grid.IsPassable(GoalNode, RequiredClearance) || (bUseOccupancy && !IsCellFree(GoalNode)))
+	{
+		GoalNode = bUseOccupancy
+			? FNavPathfinder::FindNearestFreeNode(Grid, GoalNode, RequiredClearance, IsCellFree, Request.Options.GoalSearchRadius)
+			: FNavPathfinder::FindNearestFreeNode(Grid, GoalNode, RequiredClearance, FNavPathfinder::FAcceptAllCells(), Request.Options.GoalSearchRadius);
+	}
+
+	if (GoalNode == INDEX_NONE)
+	{
+		FNavAsyncPathResult Result;
+		Result.RequestId = Request.RequestId;
+		Results.Enqueue(MoveTemp(Result));
+		return false;
+	}
+	Request.Options.GoalNode = GoalNode;
+
+	Request.Grid = Snapshot;
+	Request.Context = FreeContexts.Num() > 0 ? FreeContexts.Pop(EAllowShrinking::No) : MakeUnique<FNavSearchContext>();
+
+	// Jump points cannot see a cell filter, so they are only used while no obstacle covers cells
+	Request.bJumpPoints = Request.Options.bUseJumpPoints && !bUseOccupancy && FNavPathfinder::SupportsJumpPoints(Grid);
+	if (Request.bJumpPoints)
+	{
+		FNavPathfinder::BeginGraphPath(FNavPathfinder::FJumpPointGraph(Grid, *Request.Context, RequiredClearance, GoalNode), *Request.Context, Request.Options.StartNode);
+	}
+	else
+	{
+		FNavPathfinder::BeginGraphPath(FNavPathfinder::FGridGraph(Grid, RequiredClearance, GoalNode), *Request.Context, Request.Options.StartNode);
+	}
+	return true;
+}
+
+ENavSearchStatus FNavSlicedPathService::StepRequest(FRequest& Request, const FNavOccupancyLayer* Occupancy, int32 MaxExpansions)
+{
+	const FNavGrid& Grid = *Request.Grid;
+	FNavSearchContext& Context = *Request.Context;
+	const FNavPathQuery& Query = Request.Options;
+
+	if (Request.bJumpPoints)
+	{
+		const FNavPathfinder::FJumpPointGraph Graph(Grid, Context, Query.RequiredClearance, Query.GoalNode);
+		return FNavPathfinder::StepGraphPath(Graph, Context, Query.GoalNode, MaxExpansions);
+	}
+
+	// Obstacles are read as they are this tick
+	const FNavPathfinder::FGridGraph Graph(Grid, Query.RequiredClearance, Query.GoalNode);
+	if (Occupancy && Occupancy->HasOccupiedCells())
+	{
+		return FNavPathfinder::StepGraphPath(Graph, Context, Query.GoalNode, MaxExpansions, nullptr, [Occupancy, &Request](int32 Cell)
+			{
+				return !Occupancy->IsOccupiedAround(Cell, Request.Options.RequiredClearance, Request.IgnoredObstacleSlot);
+			});
+	}
+	return FNavPathfinder::StepGraphPath(Graph, Context, Query.GoalNode, MaxExpansions);
+}
+
+void FNavSlicedPathService::FinishRequest(FRequest& Request, bool bSuccess, const FNavOccupancyLayer* Occupancy)
+{
+	const FNavGrid& Grid = *Request.Grid;
+	FNavSearchContext& Context = *Request.Context;
+
+	FNavAsyncPathResult Result;
+	Result.RequestId = Request.RequestId;
+	Result.bSuccess = bSuccess;
+	Result.NumExpanded = Context.NumExpanded;
+
+	if (bSuccess)
+	{
+		if (Request.bJumpPoints)
+		{
+			FNavPathfinder::ExpandJumpPoints(Grid, Context.PathNodes);
+		}
+
+		// Lazy Theta* is not resumable: any-angle requests get string pulling instead
+		if (Request.Options.bSmoothPath || Request.Options.bAnyAngle)
+		{
+			if (Occupancy && Occupancy->HasOccupiedCells())
+			{
+				FNavPathfinder::SmoothPath(Grid, Context.PathNodes, Request.Options.RequiredClearance, [Occupancy, &Request](int32 Cell)
+					{
+						return !Occupancy->IsOccupiedAround(Cell, Request.Options.RequiredClearance, Request.IgnoredObstacleSlot);
+					});
+			}
+			else
+			{
+				FNavPathfinder::SmoothPath(Grid, Context.PathNodes, Request.Options.RequiredClearance);
+			}
+		}
+
+		Result.Path.Reserve(Context.PathNodes.Num());
+		for (const int32 Node : Context.PathNodes)
+		{
+			Result.Path.Add(Grid.GetCellCenter(Node));
+		}
+	}
+
+	Results.Enqueue(MoveTemp(Result));
+	FreeContexts.Add(MoveTemp(Request.Context));
+	Request.Grid.Reset();
+}
@@ -0,0 +1,181 @@
+#include "NavSparseVoxelGraph.h"
+
+namespace NavSparseVoxelGraph
+{
+	/** Leaf faces are exact copies of split-plane coordinates; the tolerance only absorbs rounding. */
+	static constexpr double FaceTolerance = 1.e-3;
+
+	/** An undirected face contact between two graph nodes. */
+	struct FContact
+	{
+		int32 NodeA = INDEX_NONE;
+		int32 NodeB = INDEX_NONE;
+		float PortalSize = 0.0f;
+		FVector Portal = FVector::ZeroVector;
+	};
+}
+
+void FNavSparseVoxelGraph::Build(const FNavOctree& Octree)
+{
+	using namespace NavSparseVoxelGraph;
+
+	Reset();
+
+	// -------------------------------------------------------
+	// Nodes: one per free leaf
+	// -------------------------------------------------------
+	OctreeNodeToGraphNode.Init(INDEX_NONE, Octree.GetNumNodes());
+	Octree.ForEachLeaf([this, &Octree](int32 OctreeNode, const FBox& LeafBounds)
+		{
+			if (!Octree.GetNode(OctreeNode).bBlocked)
+			{
+				OctreeNodeToGraphNode[OctreeNode] = Bounds.Add(LeafBounds);
+			}
+		});
+
+	// -------------------------------------------------------
+	// Contacts: every shared face is found once, from the leaf on its low side,
+	// by collecting the leaves touching a zero-thickness slab on the leaf's max face.
+	// Neighbours may be larger, equal or smaller (several per face).
+	// -------------------------------------------------------
+	TArray<FContact> Contacts;
+	const FBox& RootBounds = Octree.GetRootBounds();
+
+	for (int32 NodeA = 0; NodeA < Bounds.Num(); ++NodeA)
+	{
+		const FBox BoundsA = Bounds[NodeA];
+		for (int32 Axis = 0; Axis < 3; ++Axis)
+		{
+			const double Plane = BoundsA.Max[Axis];
+			if (Plane >= RootBounds.Max[Axis] - FaceTolerance)
+			{
+				continue;
+			}
+
+			FBox Slab = BoundsA;
+			Slab.Min[Axis] = Plane;
+			Slab.Max[Axis] = Plane;
+
+			Octree.ForEachLeafInBox(Slab, [&](int32 OctreeNode, const FBox& BoundsB)
+				{
+					const int32 NodeB = OctreeNodeToGraphNode[OctreeNode];
+					if (NodeB == INDEX_NONE || FMath::Abs(BoundsB.Min[Axis] - Plane) > FaceTolerance)
+					{
+						return;
+					}
+
+					// The shared face must have an area (edge / corner contacts are not links)
+					FContact Contact;
+					Contact.PortalSize = MAX_flt;
+					Contact.Portal[Axis] = Plane;
+					for (int32 Tangent = 0; Tangent < 3; ++Tangent)
+					{
+						if (Tangent == Axis)
+						{
+							continue;
+						}
+
+						const double Low = FMath::Max(BoundsA.Min[Tangent], BoundsB.Min[Tangent]);
+						const double High = FMath::Min(BoundsA.Max[Tangent], BoundsB.Max[Tangent]);
+						if (High - Low <= FaceTolerance)
+						{
+							return;
+						}
+
+						Contact.Portal[Tangent] = (Low + High) * 0.5;
+						Contact.PortalSize = FMath::Min(Contact.PortalSize, static_cast<float>(High - Low));
+					}
+
+					Contact.NodeA = NodeA;
+					Contact.NodeB = NodeB;
+					Contacts.Add(Contact);
+				});
+		}
+	}
+
+	// -------------------------------------------------------
+	// Links: both directions of every contact, grouped by source node
+	// -------------------------------------------------------
+	FirstLink.Init(0, Bounds.Num() + 1);
+	for (const FContact& Contact : Contacts)
+	{
+		++FirstLink[Contact.NodeA + 1];
+		++FirstLink[Contact.NodeB + 1];
+	}
+	for (int32 Node = 0; Node < Bounds.Num(); ++Node)
+	{
+		FirstLink[Node + 1] += FirstLink[Node];
+	}
+
+	TArray<int32> Cursor(FirstLink.GetData(), Bounds.Num());
+	Links.SetNum(Contacts.Num() * 2);
+	for (const FContact& Contact : Contacts)
+	{
+		const float Cost = FVector::Distance(GetCenter(Contact.NodeA), GetCenter(Contact.NodeB));
+		Links[Cursor[Contact.NodeA]++] = FNavSparseVoxelLink{ Contact.NodeB, Cost, Contact.PortalSize, Contact.Portal };
+		Links[Cursor[Contact.NodeB]++] = FNavSparseVoxelLink{ Contact.NodeA, Cost, Contact.PortalSize, Contact.Portal };
+	}
+}
+
+void FNavSparseVoxelGraph::Reset()
+{
+	Bounds.Empty();
+	FirstLink.Empty();
+	Links.Empty();
+	OctreeNodeToGraphNode.Empty();
+}
+
+void FNavSparseVoxelGraph::Serialize(FArchive& Ar)
+{
+	Ar << Bounds;
+	FirstLink.BulkSerialize(Ar);
+	Ar << Links;
+	OctreeNodeToGraphNode.BulkSerialize(Ar);
+
+	if (!Ar.IsLoading())
+	{
+		return;
+	}
+
+	// The CSR offsets must cover Links exactly, in order (a reset graph has no offsets at all)
+	const int32 NumNodes = Bounds.Num();
+	const bool bResetGraph = NumNodes == 0 && FirstLink.Num() == 0 && Links.Num() == 0;
+	bool bValid = !Ar.IsError()
+		&& (bResetGraph || (FirstLink.Num() == NumNodes + 1 && FirstLink[0] == 0 && FirstLink.Last() == Links.Num()));
+	for (int32 Node = 0; bValid && Node < NumNodes; ++Node)
+	{
+		bValid = FirstLink[Node] <= FirstLink[Node + 1];
+	}
+	for (int32 LinkIndex = 0; bValid && LinkIndex < Links.Num(); ++LinkIndex)
+	{
+		bValid = Links[LinkIndex].Node >= 0 && Links[LinkIndex].Node < NumNodes;
+	}
+	for (int32 OctreeNode = 0; bValid && OctreeNode < OctreeNodeToGraphNode.Num(); ++OctreeNode)
+	{
+		bValid = OctreeNodeToGraphNode[OctreeNode] >= INDEX_NONE && OctreeNodeToGraphNode[OctreeNode] < NumNodes;
+	}
+
+	if (!bValid)
+	{
+		Ar.SetError();
+		Reset();
+	}
+}
+
+const FNavSparseVoxelLink* FNavSparseVoxelGraph::FindLink(int32 FromNode, int32 ToNode) const
+{
+	for (const FNavSparseVoxelLink& Link : GetLinks(FromNode))
+	{
+		if (Link.Node == ToNode)
+		{
+			return &Link;
+		}
+	}
+	return nullptr;
+}
+
+int32 FNavSparseVoxelGraph::FindNode(const FNavOctree& Octree, const FVector& WorldPoint) const
+{
+	const int32 Leaf = Octree.FindLeaf(WorldPoint);
+	return OctreeNodeToGraphNode.IsValidIndex(Leaf) ? OctreeNodeToGraphNode[Leaf] : INDEX_NONE;
+}
@@ -1,20 +1,18 @@
 #include "OctNavVolume3D.h"
-#include "NavNode.h"
 #include "ProceduralMeshComponent.h"
 #include "Materials/Material.h"
 #include "Materials/MaterialInstanceDynamic.h"
-#include "Containers/Queue.h" // TQueue
+#include "NavPathfinder.h"
+#include "NavBakedData.h"
+#include "SimpleNav3DStats.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "Tasks/Task.h"
 
-#include <queue>
-#include <vector>
-#include <unordered_set>
-#include <unordered_map>
-#include <utility>
-
-#include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 
 #include "Components/CapsuleComponent.h"
+#include "Components/PrimitiveComponent.h"
 #include "GameFramework/Character.h"
 #include "GameFramework/Actor.h"
 #include "Engine/OverlapResult.h"
@@ -25,15 +23,26 @@
 /// Global material reference for the debug grid
 static UMaterial* GridMaterial = nullptr;
 
+DECLARE_CYCLE_STAT(TEXT("Build Octree"), STAT_SimpleNav3D_BuildOctree, STATGROUP_SimpleNav3D);
+DECLARE_CYCLE_STAT(TEXT("Rebuild Dirty Regions"), STAT_SimpleNav3D_RebuildRegions, STATGROUP_SimpleNav3D);
+DECLARE_CYCLE_STAT(TEXT("Time-Sliced Searches"), STAT_SimpleNav3D_SlicedSearches, STATGROUP_SimpleNav3D);
+DECLARE_CYCLE_STAT(TEXT("Batch Searches"), STAT_SimpleNav3D_BatchSearches, STATGROUP_SimpleNav3D);
+DECLARE_CYCLE_STAT(TEXT("Incremental Replans"), STAT_SimpleNav3D_IncrementalReplans, STATGROUP_SimpleNav3D);
+
 //
 // ============================================================================
 // AOctNavVolume3D C 3D Grid Navigation Volume with Octree-Based Occlusion
 // ============================================================================
-// - Builds a 3D navigation grid composed of NavNodes
+// - Builds a compact 3D navigation grid (walkability bits, implicit neighbours)
 // - Visualizes the grid with a procedural mesh (debug grid)
 // - Builds an octree for coarse collision / blockage tests
-// - Provides A* pathfinding over the grid
-// - Supports finding nearest free node via BFS with collision checks
+// - Provides A* pathfinding over the grid or over the free octree leaves
+// - Supports finding nearest free node via a bounded shell search with collision checks
+// - Runs asynchronous path requests on worker threads
+// - Runs batches of path queries in parallel
+// - Repairs per-agent searches incrementally for agents following moving goals
+// - Rebuilds dirty regions on a worker thread and swaps the result in
+// - Rasterizes registered moving obstacles into a shared occupancy layer each tick
 // ============================================================================
 //
 
@@ -76,72 +85,44 @@ void AOctNavVolume3D::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// -------------------------------------------------------
-	// Allocate NavNode array for the entire grid
-	// -------------------------------------------------------
-	const int32 TotalNodes = GetTotalDivisions();
-	NavNodes = new NavNode[TotalNodes];
-
-	// Precomputed neighbor offset list for 3D grid adjacency:
-	//  - Above, middle, below layers.
-	//  - Used to build neighbor links between NavNodes.
-	static const TArray<FIntVector> NeighbourOffsets = {
-		// Above (z + 1)
-	   { 1, -1,  1}, { 1,  0,  1}, { 1,  1,  1},
-	   { 0, -1,  1}, { 0,  0,  1}, { 0,  1,  1},
-	   {-1, -1,  1}, {-1,  0,  1}, {-1,  1,  1},
-
-	   // Middle (z)
-	   { 1, -1,  0}, { 1,  0,  0}, { 1,  1,  0},
-	   { 0, -1,  0},               { 0,  1,  0},
-	   {-1, -1,  0}, {-1,  0,  0}, {-1,  1,  0},
-
-	   // Below (z - 1)
-	   { 1, -1, -1}, { 1,  0, -1}, { 1,  1, -1},
-	   { 0, -1, -1}, { 0,  0, -1}, { 0,  1, -1},
-	   {-1, -1, -1}, {-1,  0, -1}, {-1,  1, -1}
-	};
-
-	// Helper lambda: attempts to add a valid neighbour based on
-	// grid bounds + MinSharedNeighborAxes constraint.
-	auto AddNeighbour = [this](NavNode* Node, const FIntVector Offset)
-		{
-			const FIntVector NCoord = Node->Coordinates + Offset;
-
-			// Ignore neighbours outside of the grid
-			if (!this->AreCoordinatesValid(NCoord))
-			{
-				return;
-			}
+	// Baked data only needs its shared grid and copies of the octree and labels; otherwise build from the scene
+	const bool bLoadedBakedData = LoadBakedNavigationData();
+	if (!bLoadedBakedData)
+	{
+		BuildNavigationData();
+	}
+	DynamicOccupancy->Init(NavGrid->GetSize());
+	if (bUsePathCache)
+	{
+		PathCache.Init(NavGrid->GetSize(), PathCacheRegionSize, PathCacheCapacity);
+	}
 
-			// Count how many axes are shared with the candidate node
-			int8 SharedAxes = 0;
-			if (Node->Coordinates.X == NCoord.X) SharedAxes++;
-			if (Node->Coordinates.Y == NCoord.Y) SharedAxes++;
-			if (Node->Coordinates.Z == NCoord.Z) SharedAxes++;
+	// Components of every free cell up front when building anyway; larger agent size classes (and
+	// bakes without labels) are labelled on first query
+	if (!bLoadedBakedData && UsesComponentLabels() && !UsesSparseVoxelGraph())
+	{
+		FindOrBuildComponentLabels(1);
+	}
 
-			// Only connect neighbours that share enough axes (e.g., 6- or 18-connected)
-			if (SharedAxes >= this->MinSharedNeighborAxes && SharedAxes < 3)
-			{
-				Node->Neighbours.push_back(GetNode(NCoord));
-			}
-		};
+#if WITH_EDITOR
+	if (SearchMode == ENavSearchMode::ENSM_JumpPoint && !FNavPathfinder::SupportsJumpPoints(*NavGrid))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D: Jump point search needs MinSharedNeighborAxes = 0; using plain A*."));
+	}
+#endif
+}
 
+void AOctNavVolume3D::BuildNavigationData()
+{
 	// -------------------------------------------------------
-	// Populate all NavNodes and build neighbour adjacency
+	// Allocate compact grid storage for the entire volume.
+	// Neighbours are implicit (generated from the offset table on
+	// demand), so no per-cell adjacency has to be built here.
+	// A fresh grid is allocated: the previous one may be shared
+	// with baked data or async workers.
 	// -------------------------------------------------------
-	for (int32 Z = 0; Z < DivisionsZ; ++Z)
-		for (int32 Y = 0; Y < DivisionsY; ++Y)
-			for (int32 X = 0; X < DivisionsX; ++X)
-			{
-				NavNode* Node = GetNode({ X, Y, Z });
-				Node->Coordinates = { X, Y, Z };
-
-				for (const FIntVector& Offset : NeighbourOffsets)
-				{
-					AddNeighbour(Node, Offset);
-				}
-			}
+	NavGrid = MakeShared<FNavGrid, ESPMode::ThreadSafe>();
+	NavGrid->Init(DivisionsX, DivisionsY, DivisionsZ, MinSharedNeighborAxes, GetWorldAlignedVolumeBox().Min, DivisionSize, bUseBrickStorage);
 
 	// -------------------------------------------------------
 	// Build octree for coarse occupancy / blockage queries
@@ -149,20 +130,180 @@ void AOctNavVolume3D::BeginPlay()
 	DestroyOctree(); // Destroy any previous tree (just in case)
 	OctreeMinCellSize = FMath::Max(OctreeMinCellSize, DivisionSize);
 	const FBox EntireGridBoxInWorld = GetWorldAlignedVolumeBox();
-	OctreeRoot = BuildOctree(EntireGridBoxInWorld, 0, TArray<TEnumAsByte<EObjectTypeQuery>>(), nullptr);
+	BuildOctree(EntireGridBoxInWorld, TArray<TEnumAsByte<EObjectTypeQuery>>(), nullptr);
+
+	// -------------------------------------------------------
+	// Bake octree blockage into the per-cell bitfield used by A*
+	// -------------------------------------------------------
+	BakeOctreeOccupancy(Octree, *NavGrid, FIntVector::ZeroValue, NavGrid->GetSize() - FIntVector(1, 1, 1));
+
+	// -------------------------------------------------------
+	// Link free octree leaves for the sparse voxel search mode
+	// -------------------------------------------------------
+	if (SearchMode == ENavSearchMode::ENSM_SparseVoxel)
+	{
+		SparseVoxelGraph.Build(Octree);
+
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Log, TEXT("OctNavVolume3D:: Sparse voxel graph built (%d nodes, %d links)."),
+			SparseVoxelGraph.GetNumNodes(),
+			SparseVoxelGraph.GetNumLinks());
+#endif
+	}
+
+	// -------------------------------------------------------
+	// Derive the clearance field (agent-size checks without physics)
+	// -------------------------------------------------------
+	if (bUseClearanceField)
+	{
+		NavGrid->BuildClearance(MaxClearanceCells);
+	}
+
+#if WITH_EDITOR
+	UE_LOG(LogTemp, Log, TEXT("OctNavVolume3D:: Grid storage uses %.2f MB for %d cells (%s)."),
+		NavGrid->GetAllocatedSize() / (1024.0 * 1024.0),
+		NavGrid->GetNumCells(),
+		NavGrid->UsesBrickStorage() ? TEXT("bricks") : TEXT("flat"));
+#endif
 }
 
 void AOctNavVolume3D::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	// Cleanup octree and NavNode array
+	// Stop background work first: region rebuilds query the world, async searches read the grid
+	if (RegionRebuildTask.IsValid())
+	{
+		RegionRebuildTask.Wait();
+	}
+	RegionRebuildTask = UE::Tasks::FTask();
+	RegionRebuild.Reset();
+	PendingDirtyRegions.Empty();
+	DynamicPrimitives.Empty();
+	DynamicObstacles.Empty();
+
+	AsyncPathService.Shutdown();
+	AsyncPathCallbacks.Empty();
+	SlicedPathService.Reset();
+	SlicedPathCallbacks.Empty();
+	BatchPathService.Reset();
+	IncrementalPlanners.Empty();
+
+	// Cleanup octree, search graphs and grid storage
 	DestroyOctree();
-
-	delete[] NavNodes;
-	NavNodes = nullptr;
+	SparseVoxelGraph.Reset();
+	ClusterGraphs.Empty();
+	ComponentLabels.Empty();
+	PathCache.Reset();
+	ClearFlowField();
+	NavGrid = MakeShared<FNavGrid, ESPMode::ThreadSafe>();
+	DynamicOccupancy = MakeShared<FNavOccupancyLayer, ESPMode::ThreadSafe>();
 
 	Super::EndPlay(EndPlayReason);
 }
 
+//
+// ============================================================================
+// Baked Navigation Data
+// ============================================================================
+//
+
+FNavBakeSettings AOctNavVolume3D::GetBakeSettings()
+{
+	FNavBakeSettings Settings;
+	Settings.GridSize = FIntVector(FMath::Max(DivisionsX, 1), FMath::Max(DivisionsY, 1), FMath::Max(DivisionsZ, 1));
+	Settings.Origin = GetWorldAlignedVolumeBox().Min;
+	Settings.CellSize = DivisionSize;
+	Settings.MinSharedNeighborAxes = MinSharedNeighborAxes;
+	Settings.MaxClearanceCells = bUseClearanceField ? FMath::Clamp(MaxClearanceCells, 1, 255) : 0;
+	Settings.OctreeMinCellSize = FMath::Max(OctreeMinCellSize, DivisionSize);
+	Settings.OctreeMaxDepth = OctreeMaxDepth;
+	Settings.bBrickStorage = bUseBrickStorage;
+	return Settings;
+}
+
+bool AOctNavVolume3D::LoadBakedNavigationData()
+{
+	if (!BakedData)
+	{
+		return false;
+	}
+
+	if (!BakedData->Matches(GetBakeSettings()))
+	{
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D: %s was baked with other volume settings (or is empty); building at runtime. Bake it again to skip the build."),
+			*BakedData->GetName());
+#endif
+		return false;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	// The grid is shared as is (never mutated in place after BeginPlay); the octree is copied
+	// because region rebuilds replace it
+	NavGrid = BakedData->GetGrid();
+	Octree = BakedData->GetOctree();
+	OctreeMinCellSize = FMath::Max(OctreeMinCellSize, DivisionSize);
+
+	SparseVoxelGraph.Reset();
+	if (SearchMode == ENavSearchMode::ENSM_SparseVoxel)
+	{
+		if (BakedData->HasSparseVoxelGraph())
+		{
+			SparseVoxelGraph = BakedData->GetSparseVoxelGraph();
+		}
+		else
+		{
+			SparseVoxelGraph.Build(Octree);
+		}
+	}
+
+	// Copied because region rebuilds relabel
+	if (UsesComponentLabels() && BakedData->HasComponentLabels())
+	{
+		const FNavComponentLabels& BakedLabels = BakedData->GetComponentLabels();
+		ComponentLabels.Add(BakedLabels.GetRequiredClearance(), BakedLabels);
+	}
+
+#if WITH_EDITOR
+	UE_LOG(LogTemp, Log, TEXT("OctNavVolume3D:: Loaded baked navigation data from %s in %.2f ms (%d cells, %d octree nodes)."),
+		*BakedData->GetName(),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0,
+		NavGrid->GetNumCells(),
+		Octree.GetNumNodes());
+#endif
+	return true;
+}
+
+#if WITH_EDITOR
+void AOctNavVolume3D::BakeNavigationData()
+{
+	if (!BakedData)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D: Assign a NavBakedData asset to BakedData before baking."));
+		return;
+	}
+
+	// Build exactly what BeginPlay would, store it, and drop the editor copy again
+	BuildNavigationData();
+	FNavComponentLabels Labels;
+	if (UsesComponentLabels() && !UsesSparseVoxelGraph())
+	{
+		Labels.Build(*NavGrid, 1);
+	}
+	BakedData->Modify();
+	BakedData->Store(GetBakeSettings(), *NavGrid, Octree, SearchMode == ENavSearchMode::ENSM_SparseVoxel ? &SparseVoxelGraph : nullptr, Labels.IsBuilt() ? &Labels : nullptr);
+
+	UE_LOG(LogTemp, Log, TEXT("OctNavVolume3D:: Baked navigation data into %s (%d cells, %d octree nodes). Save the asset to keep it."),
+		*BakedData->GetName(),
+		NavGrid->GetNumCells(),
+		Octree.GetNumNodes());
+
+	DestroyOctree();
+	SparseVoxelGraph.Reset();
+	NavGrid = MakeShared<FNavGrid, ESPMode::ThreadSafe>();
+}
+#endif
+
 //
 // ============================================================================
 // Debug Grid Mesh Generation
@@ -240,11 +381,8 @@ void AOctNavVolume3D::ClampCoordinatesToGrid(FIntVector& Coordinates)
 
 void AOctNavVolume3D::DestroyOctree()
 {
-	if (OctreeRoot)
-	{
-		delete OctreeRoot;
-		OctreeRoot = nullptr;
-	}
+	// All nodes live in one arena: a single deallocation
+	Octree.Reset();
 }
 
 //
@@ -269,9 +407,8 @@ FBox AOctNavVolume3D::GetWorldAlignedVolumeBox()
 
 FIntVector AOctNavVolume3D::ConvertWorldLocationToGridCoordinates(const FVector& WorldCoordinate)
 {
-	// Transform world-space location into local grid space
-	FTransform GridTransform = GetActorTransform();
-	const FVector GridSpacePos = UKismetMathLibrary::InverseTransformLocation(GridTransform, WorldCoordinate);
+	// Transform world-space location into local grid space (translation only, like the octree bounds)
+	const FVector GridSpacePos = WorldCoordinate - GetActorLocation();
 
 	FIntVector GridSpaceCoords;
 
@@ -294,8 +431,8 @@ FVector AOctNavVolume3D::ConvertGridCoordinatesToWorldLocation(const FIntVector&
 	GridSpacePos.Y = (GridCoordsCopy.Y * DivisionSize) + EdgeToCenterOffset;
 	GridSpacePos.Z = (GridCoordsCopy.Z * DivisionSize) + EdgeToCenterOffset;
 
-	// Transform back to world space
-	return UKismetMathLibrary::TransformLocation(GetActorTransform(), GridSpacePos);
+	// Transform back to world space (translation only, like the octree bounds)
+	return GridSpacePos + GetActorLocation();
 }
 
 //
@@ -304,112 +441,38 @@ FVector AOctNavVolume3D::ConvertGridCoordinatesToWorldLocation(const FIntVector&
 // ============================================================================
 //
 
-bool AOctNavVolume3D::IsActorOverlapping(
+FNavOverlapQuery::FNavOverlapQuery(
 	float InAgentRadius,
 	float InAgentHalfHeight,
 	AActor* IgnoreActor,
-	const FVector& InWorldLocation,
-	const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
-	UClass* InActorClassFilter) const
+	const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes)
+	: QueryParams(SCENE_QUERY_STAT(IsActorOverlappingTest), false)
+	, Shape(FCollisionShape::MakeCapsule(InAgentRadius, InAgentHalfHeight))
 {
 	// Build object type query params based on provided object types
-	FCollisionObjectQueryParams ObjectParams;
 	for (TEnumAsByte<EObjectTypeQuery> ObjType : InObjectTypes)
 	{
 		ObjectParams.AddObjectTypesToQuery(UEngineTypes::ConvertToCollisionChannel(ObjType));
 	}
 
 	// Configure collision query (optional ignored actor)
-	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(IsActorOverlappingTest), false);
 	QueryParams.bFindInitialOverlaps = true;
 	if (IgnoreActor)
 	{
 		QueryParams.AddIgnoredActor(IgnoreActor);
 	}
+}
 
-	// Capsule representing agent
-	const FCollisionShape CapsuleShape =
-		FCollisionShape::MakeCapsule(InAgentRadius, InAgentHalfHeight);
-
-	TArray<FOverlapResult> OverlapResults;
-	const bool bHit = GetWorld()->OverlapMultiByObjectType(
-		OverlapResults,
+bool AOctNavVolume3D::IsActorOverlapping(const FNavOverlapQuery& InQuery, const FVector& InWorldLocation) const
+{
+	// Only a yes/no answer is needed, so stop at the first overlap instead of collecting them all
+	return GetWorld()->OverlapAnyTestByObjectType(
 		InWorldLocation,
 		FQuat::Identity,
-		ObjectParams,
-		CapsuleShape,
-		QueryParams
+		InQuery.ObjectParams,
+		InQuery.Shape,
+		InQuery.QueryParams
 	);
-
-	return bHit;
-}
-
-//
-// ============================================================================
-// Nearest Free Node Search (BFS over grid)
-// ============================================================================
-//
-
-NavNode* AOctNavVolume3D::FindNearestFreeNode(
-	NavNode* InFromNode,
-	AActor* IgnoredActor,
-	const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
-	UClass* InActorClassFilter,
-	float InDetectionRadius,
-	float InDetectionHalfHeight)
-{
-	if (!InFromNode || AreCoordinatesValid(InFromNode->Coordinates) == false)
-	{
-		return nullptr;
-	}
-
-	// BFS over grid nodes starting from InFromNode
-	TQueue<NavNode*> Queue;
-	TSet<NavNode*> Visited;
-
-	Queue.Enqueue(InFromNode);
-	Visited.Add(InFromNode);
-
-	while (!Queue.IsEmpty())
-	{
-		NavNode* CurNode;
-		Queue.Dequeue(CurNode);
-
-		FVector NodeWorldLocation = ConvertGridCoordinatesToWorldLocation(CurNode->Coordinates);
-
-		// Skip nodes marked as blocked in the octree
-		if (OctreeRoot && QueryPointBlocked(NodeWorldLocation))
-		{
-			// Node is blocked at octree level, continue search
-		}
-		else
-		{
-			// Additional check: ensure no dynamic actor overlap for this agent/capsule
-			if (!IsActorOverlapping(
-				InDetectionRadius,
-				InDetectionHalfHeight,
-				IgnoredActor,
-				NodeWorldLocation,
-				InObjectTypes,
-				InActorClassFilter))
-			{
-				return CurNode;
-			}
-		}
-
-		// Enqueue neighbours that were not visited yet
-		for (NavNode* Neighbour : CurNode->Neighbours)
-		{
-			if (!Visited.Contains(Neighbour))
-			{
-				Queue.Enqueue(Neighbour);
-				Visited.Add(Neighbour);
-			}
-		}
-	}
-
-	// No free node found reachable from the starting node
-	return nullptr;
 }
 
 //
@@ -418,62 +481,52 @@ NavNode* AOctNavVolume3D::FindNearestFreeNode(
 // ============================================================================
 //
 
-FOctreeNode* AOctNavVolume3D::BuildOctree(
+void AOctNavVolume3D::BuildOctree(
 	const FBox& InBox,
-	int32 InDepth,
 	const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
 	UClass* InActorClassFilter)
 {
-	// Create node representing the current bounding box
-	FOctreeNode* TreeNode = new FOctreeNode(InBox);
-
-	// Leaf condition based on max side length and max depth
-	const FVector BoxSize = InBox.GetSize();
-	const float MaxSideLength = FMath::Max3(BoxSize.X, BoxSize.Y, BoxSize.Z);
-
-	const bool bSmallEnough = (MaxSideLength <= OctreeMinCellSize + KINDA_SMALL_NUMBER);
-	const bool bMaxDepthReached = (InDepth >= OctreeMaxDepth);
-
-	// Leaf node: determine if this box is blocked
-	if (bSmallEnough || bMaxDepthReached)
-	{
-		TreeNode->bIsLeaf = true;
-		TreeNode->bBlocked = IsBoxBlocked(InBox, InObjectTypes, InActorClassFilter);
-		return TreeNode;
-	}
+	SCOPE_CYCLE_COUNTER(STAT_SimpleNav3D_BuildOctree);
+	const double StartTime = FPlatformTime::Seconds();
 
-	// Internal node: split into 8 child boxes
-	TreeNode->bIsLeaf = false;
-	const FVector C = InBox.GetCenter();
-	const FVector Min = InBox.Min;
-	const FVector Max = InBox.Max;
+	// -------------------------------------------------------
+	// Pass 1: build the node hierarchy. The split rule only depends on
+	// box size and depth, so the topology is known without any scene query.
+	// -------------------------------------------------------
+	TArray<FNavOctreeLeaf> Leaves;
+	Octree.Build(InBox, OctreeMinCellSize, OctreeMaxDepth, Leaves);
 
-	FBox ChildBoxes[8] = {
-		FBox(FVector(Min.X, Min.Y, Min.Z), FVector(C.X,   C.Y,   C.Z)),   // 0
-		FBox(FVector(C.X,  Min.Y, Min.Z), FVector(Max.X,  C.Y,   C.Z)),   // 1
-		FBox(FVector(Min.X, C.Y,  Min.Z), FVector(C.X,    Max.Y,  C.Z)),  // 2
-		FBox(FVector(C.X,  C.Y,  Min.Z), FVector(Max.X,   Max.Y,  C.Z)),  // 3
-		FBox(FVector(Min.X, Min.Y, C.Z), FVector(C.X,     C.Y,    Max.Z)),// 4
-		FBox(FVector(C.X,  Min.Y, C.Z), FVector(Max.X,    C.Y,    Max.Z)),// 5
-		FBox(FVector(Min.X, C.Y,  C.Z), FVector(C.X,      Max.Y,  Max.Z)),// 6
-		FBox(FVector(C.X,  C.Y,  C.Z), FVector(Max.X,     Max.Y,  Max.Z)) // 7
-	};
+	// -------------------------------------------------------
+	// Pass 2: one overlap test per leaf. Leaves are independent and the scene
+	// is not modified while BeginPlay waits here, so the tests fan out across
+	// worker threads. Each leaf writes only its own flag, so the result is
+	// identical to a serial build.
+	// -------------------------------------------------------
+	ParallelFor(Leaves.Num(), [this, &Leaves, &InObjectTypes, InActorClassFilter](int32 LeafIndex)
+		{
+			const FNavOctreeLeaf& Leaf = Leaves[LeafIndex];
+			Octree.GetNode(Leaf.NodeIndex).bBlocked = IsBoxBlocked(Leaf.Bounds, InObjectTypes, InActorClassFilter);
+		},
+		bParallelOctreeBuild ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
 
-	bool bAllBlocked = true;
-	for (int i = 0; i < 8; ++i)
-	{
-		TreeNode->Children[i] = BuildOctree(ChildBoxes[i], InDepth + 1, InObjectTypes, InActorClassFilter);
-		bAllBlocked &= (TreeNode->Children[i]->bIsLeaf && TreeNode->Children[i]->bBlocked);
-	}
+	// -------------------------------------------------------
+	// Pass 3: merge subtrees whose leaves are all blocked (or all free)
+	// -------------------------------------------------------
+	Octree.CollapseUniformSubtrees();
 
-	// TODO: If all children are blocked leaves, we can mark this node as a blocked leaf and delete its children for memory optimization.
-	return TreeNode;
+#if WITH_EDITOR
+	UE_LOG(LogTemp, Log, TEXT("OctNavVolume3D:: Octree built in %.2f ms (%d leaves tested, %d nodes after collapsing, %s)."),
+		(FPlatformTime::Seconds() - StartTime) * 1000.0,
+		Leaves.Num(),
+		Octree.GetNumNodes(),
+		bParallelOctreeBuild ? TEXT("parallel") : TEXT("serial"));
+#endif
 }
 
 bool AOctNavVolume3D::IsBoxBlocked(
 	const FBox& InBox,
 	const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
-	UClass* InActorClassFilter)
+	UClass* InActorClassFilter) const
 {
 	// Build list of collision channels to query against
 	FCollisionObjectQueryParams ObjectCollisionParams;
@@ -502,106 +555,489 @@ bool AOctNavVolume3D::IsBoxBlocked(
 
 bool AOctNavVolume3D::QueryPointBlocked(const FVector& WorldPoint) const
 {
-	if (!OctreeRoot)
-	{
-		return false;
-	}
+	return Octree.IsPointBlocked(WorldPoint);
+}
 
-	// Traverse octree down to the leaf that contains WorldPoint
-	const FOctreeNode* CurrentNode = OctreeRoot;
-	while (CurrentNode && !CurrentNode->bIsLeaf)
+void AOctNavVolume3D::BakeOctreeOccupancy(const FNavOctree& InOctree, FNavGrid& InGrid, const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	if (!InGrid.IsInitialized())
 	{
-		const FVector Center = CurrentNode->Bounds.GetCenter();
-		const bool bIsHighX = WorldPoint.X >= Center.X;
-		const bool bIsHighY = WorldPoint.Y >= Center.Y;
-		const bool bIsHighZ = WorldPoint.Z >= Center.Z;
+		return;
+	}
 
-		const int CorrectChildIndex =
-			(bIsHighX ? 1 : 0)
-			| ((bIsHighY ? 1 : 0) << 1)
-			| ((bIsHighZ ? 1 : 0) << 2);
+	// Start from an all-free range, then mark the cells covered by blocked leaves
+	InGrid.SetBlockedRange(MinCell, MaxCell, false);
 
-		CurrentNode = CurrentNode->Children[CorrectChildIndex];
-	}
+	// Blocked leaf: mark every cell of the range whose center falls inside it
+	// (same containment rule QueryPointBlocked uses when descending).
+	// Collapsed leaves cover exactly the cells of the leaves they replaced.
+	const FBox RangeCenters(InGrid.GetCellCenter(MinCell), InGrid.GetCellCenter(MaxCell));
+	InOctree.ForEachLeafInBox(RangeCenters, [&InOctree, &InGrid, &MinCell, &MaxCell](int32 NodeIndex, const FBox& Bounds)
+		{
+			FIntVector LeafMin, LeafMax;
+			if (!InOctree.GetNode(NodeIndex).bBlocked || !InGrid.GetCellRangeInBox(Bounds, LeafMin, LeafMax))
+			{
+				return;
+			}
 
-	return (CurrentNode) ? CurrentNode->bBlocked : false;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				LeafMin[Axis] = FMath::Max(LeafMin[Axis], MinCell[Axis]);
+				LeafMax[Axis] = FMath::Min(LeafMax[Axis], MaxCell[Axis]);
+				if (LeafMin[Axis] > LeafMax[Axis])
+				{
+					return;
+				}
+			}
+			InGrid.SetBlockedRange(LeafMin, LeafMax, true);
+		});
 }
 
 //
 // ============================================================================
-// Editor Construction C Build Debug Grid Mesh
+// Dynamic Geometry (dirty region rebuilds)
 // ============================================================================
 //
 
-void AOctNavVolume3D::OnConstruction(const FTransform& Transform)
+void AOctNavVolume3D::MarkDirtyRegion(const FBox& WorldBox)
 {
-	Super::OnConstruction(Transform);
-
-#if WITH_EDITOR
-	// Enforce axis-aligned, unit-scale volume for simplicity
-	if (!Transform.GetRotation().IsIdentity())
+	if (!NavGrid->IsInitialized() || !WorldBox.IsValid)
 	{
-		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D: Rotation is ignored. Please keep this actor unrotated."));
+		return;
 	}
 
-	if (!Transform.GetScale3D().Equals(FVector(1.f, 1.f, 1.f), KINDA_SMALL_NUMBER))
+	// Only the part inside the volume matters
+	const FBox Region = WorldBox.Overlap(Octree.GetRootBounds());
+	if (!Region.IsValid)
 	{
-		UE_LOG(LogTemp, Warning,
-			TEXT("OctNavVolume3D: Scale is ignored. Please keep scale = (1,1,1)."));
+		return;
 	}
-#endif
 
-	TArray<FVector> Vertices;
-	TArray<int32> TrianglesIndexArray;
+	// Cached paths through the box may already be wrong; they are dropped again once the rebuild lands
+	FIntVector MinCell, MaxCell;
+	if (NavGrid->GetCellRangeInBox(Region, MinCell, MaxCell))
+	{
+		InvalidatePathCache(MinCell, MaxCell);
+	}
 
-	// Estimated number of grid lines for all three planes (XY, YZ, XZ)
-	const uint32 EstimateLineCount =
-		(DivisionsX + 1) * (DivisionsY + 1) * 2   // XY planes
-		+ (DivisionsY + 1) * (DivisionsZ + 1) * 2 // YZ planes
-		+ (DivisionsX + 1) * (DivisionsZ + 1) * 2; // XZ planes
+	// Grow an overlapping pending box instead of queueing another one, so a primitive moving
+	// every frame while a rebuild runs does not pile up boxes
+	for (FBox& Pending : PendingDirtyRegions)
+	{
+		if (Pending.Intersect(Region))
+		{
+			Pending += Region;
+			return;
+		}
+	}
+	PendingDirtyRegions.Add(Region);
+}
 
-	const uint32 EstimateVertexCount = EstimateLineCount * 4;
-	const uint32 EstimateTriangleIndexCount = EstimateLineCount * 6;
+void AOctNavVolume3D::RegisterDynamicPrimitive(UPrimitiveComponent* Primitive)
+{
+	if (!Primitive)
+	{
+		return;
+	}
 
-	Vertices.Reserve(EstimateVertexCount);
-	TrianglesIndexArray.Reserve(EstimateTriangleIndexCount);
+	for (const FNavDynamicPrimitive& Entry : DynamicPrimitives)
+	{
+		if (Entry.Primitive == Primitive)
+		{
+			return;
+		}
+	}
 
-	const float GridXBound = GetGridXBound();
-	const float GridYBound = GetGridYBound();
-	const float GridZBound = GetGridZBound();
+	// The primitive may have appeared after the bake: re-evaluate where it is now
+	FNavDynamicPrimitive& Entry = DynamicPrimitives.AddDefaulted_GetRef();
+	Entry.Primitive = Primitive;
+	Entry.LastBounds = Primitive->Bounds.GetBox();
+	MarkDirtyRegion(Entry.LastBounds);
+}
 
-	// Helper to add one thick line segment to the procedural mesh
-	auto AddLine = [this, &Vertices, &TrianglesIndexArray](const FVector& InStart, const FVector& InEnd, const FVector& InUpNormal)
+void AOctNavVolume3D::UnregisterDynamicPrimitive(UPrimitiveComponent* Primitive)
+{
+	DynamicPrimitives.RemoveAllSwap([Primitive](const FNavDynamicPrimitive& Entry)
 		{
-			this->CreateLine(InStart, InEnd, InUpNormal, Vertices, TrianglesIndexArray);
-		};
-
-	FVector Start = FVector::ZeroVector;
-	FVector End = FVector::ZeroVector;
+			return Entry.Primitive == Primitive;
+		});
+}
 
-	// -------------------------------------------------------
-	// Lines parallel to Y axis (varying X, Z fixed)
-	// -------------------------------------------------------
-	for (int32 Z = 0; Z <= DivisionsZ; ++Z)
+void AOctNavVolume3D::UpdateDynamicPrimitives()
+{
+	for (int32 Index = DynamicPrimitives.Num() - 1; Index >= 0; --Index)
 	{
-		Start.Z = DivisionSize * Z;
-		End.Z = DivisionSize * Z;
-
-		for (int32 X = 0; X <= DivisionsX; ++X)
+		FNavDynamicPrimitive& Entry = DynamicPrimitives[Index];
+		const UPrimitiveComponent* Primitive = Entry.Primitive.Get();
+		if (!Primitive)
 		{
-			Start.X = X * DivisionSize;
-			End.X = X * DivisionSize;
-
-			Start.Y = 0.0f;
-			End.Y = GridYBound;
+			// Destroyed: free the space it occupied
+			MarkDirtyRegion(Entry.LastBounds);
+			DynamicPrimitives.RemoveAtSwap(Index, 1, EAllowShrinking::No);
+			continue;
+		}
 
-			AddLine(Start, End, FVector::UpVector);
+		const FBox Bounds = Primitive->Bounds.GetBox();
+		if (!Bounds.Min.Equals(Entry.LastBounds.Min) || !Bounds.Max.Equals(Entry.LastBounds.Max))
+		{
+			// Moved: the space it left and the space it entered both change
+			MarkDirtyRegion(Entry.LastBounds);
+			MarkDirtyRegion(Bounds);
+			Entry.LastBounds = Bounds;
 		}
 	}
+}
 
-	// -------------------------------------------------------
-	// Lines parallel to X axis (varying Y, Z fixed)
-	// -------------------------------------------------------
+void AOctNavVolume3D::RegisterDynamicObstacle(AActor* Obstacle)
+{
+	if (!Obstacle || !DynamicOccupancy->IsInitialized() || FindDynamicObstacleSlot(Obstacle) != INDEX_NONE)
+	{
+		return;
+	}
+
+	// The layer may be read by async searches: slots are only added to a private copy
+	if (!DynamicOccupancy.IsUnique())
+	{
+		DynamicOccupancy = MakeShared<FNavOccupancyLayer, ESPMode::ThreadSafe>(DynamicOccupancy.Get());
+	}
+
+	FNavDynamicObstacle& Entry = DynamicObstacles.AddDefaulted_GetRef();
+	Entry.Actor = Obstacle;
+	Entry.Slot = DynamicOccupancy->AddObstacle();
+}
+
+void AOctNavVolume3D::UnregisterDynamicObstacle(AActor* Obstacle)
+{
+	for (int32 Index = 0; Index < DynamicObstacles.Num(); ++Index)
+	{
+		if (DynamicObstacles[Index].Actor == Obstacle)
+		{
+			// Cells are released by the next UpdateDynamicObstacles; mark the entry as gone
+			DynamicObstacles[Index].Actor.Reset();
+			return;
+		}
+	}
+}
+
+int32 AOctNavVolume3D::FindDynamicObstacleSlot(const AActor* Obstacle) const
+{
+	if (Obstacle)
+	{
+		for (const FNavDynamicObstacle& Entry : DynamicObstacles)
+		{
+			if (Entry.Actor == Obstacle)
+			{
+				return Entry.Slot;
+			}
+		}
+	}
+	return INDEX_NONE;
+}
+
+void AOctNavVolume3D::UpdateDynamicObstacles()
+{
+	if (DynamicObstacles.Num() == 0)
+	{
+		return;
+	}
+
+	// Destroyed or unregistered obstacles release their slot
+	TArray<int32, TInlineAllocator<8>> RemovedSlots;
+	DynamicObstacles.RemoveAllSwap([this, &RemovedSlots](const FNavDynamicObstacle& Entry)
+		{
+			if (Entry.Actor.IsValid())
+			{
+				return false;
+			}
+			if (Entry.bHasCells)
+			{
+				InvalidateObstacleCells(Entry.MinCell, Entry.MaxCell);
+			}
+			RemovedSlots.Add(Entry.Slot);
+			return true;
+		});
+
+	// -------------------------------------------------------
+	// Rasterize every obstacle to the cells its collision bounds touch.
+	// Only ranges that changed (crossed a cell boundary) go to the layer.
+	// -------------------------------------------------------
+	TArray<int32, TInlineAllocator<32>> ChangedObstacles;
+	for (int32 Index = 0; Index < DynamicObstacles.Num(); ++Index)
+	{
+		FNavDynamicObstacle& Entry = DynamicObstacles[Index];
+
+		FVector Origin, Extent;
+		Entry.Actor->GetActorBounds(true, Origin, Extent);
+
+		// Growing the bounds by half a cell turns "center inside" into "cell touched"
+		FIntVector MinCell, MaxCell;
+		const bool bHasCells = NavGrid->GetCellRangeInBox(FBox(Origin - Extent, Origin + Extent).ExpandBy(DivisionSize * 0.5f), MinCell, MaxCell);
+
+		if (bHasCells != Entry.bHasCells || (bHasCells && (MinCell != Entry.MinCell || MaxCell != Entry.MaxCell)))
+		{
+			// Cached paths and planner searches may cross the cells the obstacle left or entered
+			if (Entry.bHasCells)
+			{
+				InvalidateObstacleCells(Entry.MinCell, Entry.MaxCell);
+			}
+			if (bHasCells)
+			{
+				InvalidateObstacleCells(MinCell, MaxCell);
+			}
+
+			Entry.bHasCells = bHasCells;
+			Entry.MinCell = MinCell;
+			Entry.MaxCell = MaxCell;
+			ChangedObstacles.Add(Index);
+		}
+	}
+
+	if (ChangedObstacles.Num() == 0 && RemovedSlots.Num() == 0)
+	{
+		return;
+	}
+
+	// -------------------------------------------------------
+	// Apply to the layer. Async searches hold their own reference, so the layer
+	// is copied before writing only while one of them still reads it.
+	// -------------------------------------------------------
+	if (!DynamicOccupancy.IsUnique())
+	{
+		DynamicOccupancy = MakeShared<FNavOccupancyLayer, ESPMode::ThreadSafe>(DynamicOccupancy.Get());
+	}
+
+	for (const int32 Slot : RemovedSlots)
+	{
+		DynamicOccupancy->RemoveObstacle(Slot);
+	}
+	for (const int32 Index : ChangedObstacles)
+	{
+		const FNavDynamicObstacle& Entry = DynamicObstacles[Index];
+		if (Entry.bHasCells)
+		{
+			DynamicOccupancy->SetObstacleRange(Entry.Slot, Entry.MinCell, Entry.MaxCell);
+		}
+		else
+		{
+			DynamicOccupancy->ClearObstacleRange(Entry.Slot);
+		}
+	}
+	DynamicOccupancy->Flush();
+}
+
+void AOctNavVolume3D::InvalidateObstacleCells(const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	// Agents keep their clearance from obstacles too, so cells up to the largest reach around them change
+	const FIntVector Padding(NavGrid->HasClearanceLayer() ? FMath::Max(NavGrid->GetMaxClearance() - 1, 0) : 0);
+	PathCache.InvalidateCells(MinCell - Padding, MaxCell + Padding);
+	NotifyIncrementalPlanners(MinCell - Padding, MaxCell + Padding);
+}
+
+void AOctNavVolume3D::LaunchRegionRebuild()
+{
+	// The worker gets private copies, so the live octree and grid stay valid for queries
+	// (and the grid snapshot for async searches) until the result is swapped in.
+	// Copying is a flat memcpy of the node arena and cell arrays; the expensive part,
+	// the overlap tests, only runs for the dirty leaves.
+	RegionRebuild = MakeShared<FNavRegionRebuild, ESPMode::ThreadSafe>();
+	RegionRebuild->Regions = MoveTemp(PendingDirtyRegions);
+	RegionRebuild->Octree = Octree;
+	RegionRebuild->Grid = MakeShared<FNavGrid, ESPMode::ThreadSafe>(*NavGrid);
+	RegionRebuild->bBuildSparseVoxelGraph = SparseVoxelGraph.IsBuilt();
+	ComponentLabels.GetKeys(RegionRebuild->ComponentLabelClearances);
+	PendingDirtyRegions.Reset();
+
+	RegionRebuildTask = UE::Tasks::Launch(UE_SOURCE_LOCATION, [this, Rebuild = RegionRebuild]()
+		{
+			RunRegionRebuild(*Rebuild);
+		});
+}
+
+void AOctNavVolume3D::RunRegionRebuild(FNavRegionRebuild& Rebuild) const
+{
+	SCOPE_CYCLE_COUNTER(STAT_SimpleNav3D_RebuildRegions);
+
+	// Same obstacle set as the initial build in BeginPlay
+	const TArray<TEnumAsByte<EObjectTypeQuery>> ObjectTypes;
+
+	for (const FBox& Region : Rebuild.Regions)
+	{
+		// -------------------------------------------------------
+		// Split collapsed leaves again inside the region and re-test only those leaves
+		// -------------------------------------------------------
+		TArray<FNavOctreeLeaf> Leaves;
+		Rebuild.Octree.RefineRegion(Region, Leaves);
+
+		ParallelFor(Leaves.Num(), [this, &Rebuild, &Leaves, &ObjectTypes](int32 LeafIndex)
+			{
+				const FNavOctreeLeaf& Leaf = Leaves[LeafIndex];
+				Rebuild.Octree.GetNode(Leaf.NodeIndex).bBlocked = IsBoxBlocked(Leaf.Bounds, ObjectTypes, nullptr);
+			},
+			bParallelOctreeBuild ? EParallelForFlags::None : EParallelForFlags::ForceSingleThread);
+		Rebuild.NumLeavesTested += Leaves.Num();
+
+		// -------------------------------------------------------
+		// Re-bake the cells whose centers lie in a re-tested leaf, then patch the clearance around them
+		// -------------------------------------------------------
+		FBox TestedBounds(ForceInit);
+		for (const FNavOctreeLeaf& Leaf : Leaves)
+		{
+			TestedBounds += Leaf.Bounds;
+		}
+
+		FIntVector MinCell, MaxCell;
+		if (TestedBounds.IsValid && Rebuild.Grid->GetCellRangeInBox(TestedBounds, MinCell, MaxCell))
+		{
+			BakeOctreeOccupancy(Rebuild.Octree, *Rebuild.Grid, MinCell, MaxCell);
+			if (Rebuild.Grid->HasClearanceLayer())
+			{
+				Rebuild.Grid->UpdateClearance(MinCell, MaxCell);
+			}
+			Rebuild.DirtyCellRanges.Emplace(MinCell, MaxCell);
+		}
+	}
+
+	Rebuild.Octree.CollapseUniformSubtrees();
+
+	if (Rebuild.bBuildSparseVoxelGraph)
+	{
+		Rebuild.SparseVoxelGraph.Build(Rebuild.Octree);
+	}
+
+	// A change can merge or split components anywhere, so every size class is relabelled
+	for (const int32 RequiredClearance : Rebuild.ComponentLabelClearances)
+	{
+		Rebuild.ComponentLabels.Add(RequiredClearance).Build(*Rebuild.Grid, RequiredClearance);
+	}
+}
+
+void AOctNavVolume3D::ApplyRegionRebuild()
+{
+	FNavRegionRebuild& Rebuild = *RegionRebuild;
+
+	// Publishing is a reference swap on the game thread: async searches already running keep
+	// the snapshot they were launched with, later dispatches pick up the new grid
+	NavGrid = Rebuild.Grid.ToSharedRef();
+	Octree = MoveTemp(Rebuild.Octree);
+	if (Rebuild.bBuildSparseVoxelGraph)
+	{
+		SparseVoxelGraph = MoveTemp(Rebuild.SparseVoxelGraph);
+	}
+
+	// Hierarchical graphs only recompute the clusters around the changed cells
+	for (TPair<int32, FNavClusterGraph>& Pair : ClusterGraphs)
+	{
+		for (const TPair<FIntVector, FIntVector>& Range : Rebuild.DirtyCellRanges)
+		{
+			Pair.Value.RebuildRegion(*NavGrid, Range.Key, Range.Value, SearchContext);
+		}
+	}
+
+	// Size classes labelled since the launch are labelled again on first use
+	ComponentLabels = MoveTemp(Rebuild.ComponentLabels);
+
+	// Cached paths were found on the old data; planners repair their searches around the changed
+	// cells and the clearance rewritten next to them
+	const FIntVector ClearancePadding(NavGrid->HasClearanceLayer() ? NavGrid->GetMaxClearance() : 0);
+	for (const TPair<FIntVector, FIntVector>& Range : Rebuild.DirtyCellRanges)
+	{
+		InvalidatePathCache(Range.Key, Range.Value);
+		NotifyIncrementalPlanners(Range.Key - ClearancePadding, Range.Value + ClearancePadding);
+	}
+
+	// Rebuild the flow field on the new grid once the pending rebuild (if any) is published; restarting
+	// it here would never publish a field while rebuilds keep coming
+	if (FlowFieldGoalCell != INDEX_NONE)
+	{
+		bFlowFieldGridChanged = true;
+	}
+
+#if WITH_EDITOR
+	UE_LOG(LogTemp, Verbose, TEXT("OctNavVolume3D:: Rebuilt %d dirty regions (%d leaves tested, %d nodes after collapsing)."),
+		Rebuild.Regions.Num(),
+		Rebuild.NumLeavesTested,
+		Octree.GetNumNodes());
+#endif
+
+	RegionRebuild.Reset();
+	RegionRebuildTask = UE::Tasks::FTask();
+}
+
+//
+// ============================================================================
+// Editor Construction C Build Debug Grid Mesh
+// ============================================================================
+//
+
+void AOctNavVolume3D::OnConstruction(const FTransform& Transform)
+{
+	Super::OnConstruction(Transform);
+
+#if WITH_EDITOR
+	// Enforce axis-aligned, unit-scale volume for simplicity
+	if (!Transform.GetRotation().IsIdentity())
+	{
+		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D: Rotation is ignored. Please keep this actor unrotated."));
+	}
+
+	if (!Transform.GetScale3D().Equals(FVector(1.f, 1.f, 1.f), KINDA_SMALL_NUMBER))
+	{
+		UE_LOG(LogTemp, Warning,
+			TEXT("OctNavVolume3D: Scale is ignored. Please keep scale = (1,1,1)."));
+	}
+#endif
+
+	TArray<FVector> Vertices;
+	TArray<int32> TrianglesIndexArray;
+
+	// Estimated number of grid lines for all three planes (XY, YZ, XZ)
+	const uint32 EstimateLineCount =
+		(DivisionsX + 1) * (DivisionsY + 1) * 2   // XY planes
+		+ (DivisionsY + 1) * (DivisionsZ + 1) * 2 // YZ planes
+		+ (DivisionsX + 1) * (DivisionsZ + 1) * 2; // XZ planes
+
+	const uint32 EstimateVertexCount = EstimateLineCount * 4;
+	const uint32 EstimateTriangleIndexCount = EstimateLineCount * 6;
+
+	Vertices.Reserve(EstimateVertexCount);
+	TrianglesIndexArray.Reserve(EstimateTriangleIndexCount);
+
+	const float GridXBound = GetGridXBound();
+	const float GridYBound = GetGridYBound();
+	const float GridZBound = GetGridZBound();
+
+	// Helper to add one thick line segment to the procedural mesh
+	auto AddLine = [this, &Vertices, &TrianglesIndexArray](const FVector& InStart, const FVector& InEnd, const FVector& InUpNormal)
+		{
+			this->CreateLine(InStart, InEnd, InUpNormal, Vertices, TrianglesIndexArray);
+		};
+
+	FVector Start = FVector::ZeroVector;
+	FVector End = FVector::ZeroVector;
+
+	// -------------------------------------------------------
+	// Lines parallel to Y axis (varying X, Z fixed)
+	// -------------------------------------------------------
+	for (int32 Z = 0; Z <= DivisionsZ; ++Z)
+	{
+		Start.Z = DivisionSize * Z;
+		End.Z = DivisionSize * Z;
+
+		for (int32 X = 0; X <= DivisionsX; ++X)
+		{
+			Start.X = X * DivisionSize;
+			End.X = X * DivisionSize;
+
+			Start.Y = 0.0f;
+			End.Y = GridYBound;
+
+			AddLine(Start, End, FVector::UpVector);
+		}
+	}
+
+	// -------------------------------------------------------
+	// Lines parallel to X axis (varying Y, Z fixed)
+	// -------------------------------------------------------
 	for (int32 Z = 0; Z <= DivisionsZ; ++Z)
 	{
 		Start.Z = DivisionSize * Z;
@@ -667,8 +1103,26 @@ void AOctNavVolume3D::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	// Currently no per-frame behavior needed for the volume.
-	// Hook for future dynamic visualization or debug updates.
+	// Swap in a finished region rebuild, then start the next one for regions dirtied meanwhile
+	UpdateDynamicPrimitives();
+	if (RegionRebuild.IsValid() && RegionRebuildTask.IsCompleted())
+	{
+		ApplyRegionRebuild();
+	}
+	if (!RegionRebuild.IsValid() && PendingDirtyRegions.Num() > 0)
+	{
+		LaunchRegionRebuild();
+	}
+
+	// Rasterize movers once for every query of this frame
+	UpdateDynamicObstacles();
+
+	// Launch waiting async path requests, then hand finished ones to their callbacks
+	AsyncPathService.Dispatch(NavGrid, DynamicOccupancy, MaxConcurrentAsyncSearches);
+	DeliverAsyncPathResults();
+
+	UpdateSlicedPathRequests();
+	StepFlowField();
 }
 
 //
@@ -677,22 +1131,20 @@ void AOctNavVolume3D::Tick(float DeltaTime)
 // ============================================================================
 //
 
-NavNode* AOctNavVolume3D::GetNode(FIntVector Coordinates)
+int32 AOctNavVolume3D::GetNode(FIntVector Coordinates) const
 {
-	// Clamp coordinates into valid grid range
-	ClampCoordinatesToGrid(Coordinates);
-
-	const int32 DivisionPerLevel = DivisionsX * DivisionsY;
-	const int32 Index =
-		(Coordinates.Z * DivisionPerLevel) +
-		(Coordinates.Y * DivisionsX) +
-		Coordinates.X;
-
-	if (Index < 0 || Index >= GetTotalDivisions())
+	if (!NavGrid->IsInitialized())
 	{
-		return nullptr;
+		return INDEX_NONE;
 	}
-	return &NavNodes[Index];
+
+	// Clamp coordinates into valid grid range
+	const FIntVector Size = NavGrid->GetSize();
+	Coordinates.X = FMath::Clamp(Coordinates.X, 0, Size.X - 1);
+	Coordinates.Y = FMath::Clamp(Coordinates.Y, 0, Size.Y - 1);
+	Coordinates.Z = FMath::Clamp(Coordinates.Z, 0, Size.Z - 1);
+
+	return NavGrid->GetIndex(Coordinates);
 }
 
 //
@@ -712,12 +1164,30 @@ bool AOctNavVolume3D::FindPath(
 	float InDetectionHalfHeight /*= 44.f */)
 {
 	OutPath.Reset();
+	FVector GoalLocation;
+	if (!FindPathNodes(InStart, InDestination, InObjectTypes, InActorClassFilter, InActor, InDetectionRadius, InDetectionHalfHeight, GoalLocation))
+	{
+		return false;
+	}
+	CopyPathPoints(InStart, GoalLocation, OutPath);
+	return true;
+}
 
-	// Convert world-space start/destination to grid nodes
-	NavNode* StartNode = GetNode(ConvertWorldLocationToGridCoordinates(InStart));
-	NavNode* GoalNode = GetNode(ConvertWorldLocationToGridCoordinates(InDestination));
+bool AOctNavVolume3D::FindPathNodes(
+	const FVector& InStart,
+	const FVector& InDestination,
+	const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
+	UClass* InActorClassFilter,
+	AActor* InActor,
+	float InDetectionRadius,
+	float InDetectionHalfHeight,
+	FVector& OutGoalLocation)
+{
+	// Convert world-space start/destination to grid cells
+	const int32 StartNode = GetNode(ConvertWorldLocationToGridCoordinates(InStart));
+	int32 GoalNode = GetNode(ConvertWorldLocationToGridCoordinates(InDestination));
 
-	if (!StartNode || !GoalNode)
+	if (StartNode == INDEX_NONE || GoalNode == INDEX_NONE)
 	{
 #if WITH_EDITOR
 		UE_LOG(LogTemp, Warning, TEXT("Start or End node not found"));
@@ -725,174 +1195,738 @@ bool AOctNavVolume3D::FindPath(
 		return false;
 	}
 
-	bool HasGoalFinalized = false;
-
 	// -------------------------------------------------------
-	// Snap goal to nearest free node if original goal is blocked
-	// (by static geometry via octree and/or dynamic overlap)
+	// Agent size -> clearance requirement
 	// -------------------------------------------------------
-	if (OctreeRoot && QueryPointBlocked(ConvertGridCoordinatesToWorldLocation(GoalNode->Coordinates)))
+	// With the clearance field a cell fits the agent when its distance to the nearest
+	// blocked cell covers the capsule; without it only the cell itself must be free.
+	const int32 RequiredClearance = NavGrid->HasClearanceLayer()
+		? NavGrid->GetRequiredClearance(InDetectionRadius, InDetectionHalfHeight)
+		: 1;
+
+	// Physics overlaps are an opt-in refinement for dynamic actors, or the only agent-size
+	// test when no clearance field was built. The query params are built once per query.
+	TOptional<FNavOverlapQuery> OverlapQueryStorage;
+	if (bUseDynamicOverlapChecks || !NavGrid->HasClearanceLayer())
 	{
-		if (NavNode* NewGoal = FindNearestFreeNode(
-			GoalNode,
-			InActor,
-			InObjectTypes,
-			InActorClassFilter,
-			InDetectionRadius,
-			InDetectionHalfHeight))
-		{
-			GoalNode = NewGoal;
-			HasGoalFinalized = true;
-		}
-		else
-		{
-			if (GEngine)
-			{
-				GEngine->AddOnScreenDebugMessage(
-					-1, 5.f, FColor::Red,
-					TEXT("No free goal node found near destination"));
-			}
-			return false;
-		}
+		OverlapQueryStorage.Emplace(InDetectionRadius, InDetectionHalfHeight, InActor, InObjectTypes);
 	}
+	const FNavOverlapQuery* OverlapQuery = OverlapQueryStorage.GetPtrOrNull();
+
+	// Registered movers are read from the occupancy layer rasterized this tick, widened by the
+	// agent's clearance like static geometry. The querying actor's own cells do not block it.
+	const FNavOccupancyLayer* Occupancy = GetActiveOccupancy();
+	const int32 IgnoredObstacleSlot = FindDynamicObstacleSlot(InActor);
+
+	// Cells rejected on top of the clearance test: the agent would overlap a mover, or a dynamic actor
+	const bool bFilterCells = Occupancy || OverlapQuery;
+	auto IsCellFree = [this, Occupancy, IgnoredObstacleSlot, RequiredClearance, OverlapQuery](int32 Cell)
+		{
+			return !(Occupancy && Occupancy->IsOccupiedAround(Cell, RequiredClearance, IgnoredObstacleSlot))
+				&& !(OverlapQuery && IsActorOverlapping(*OverlapQuery, NavGrid->GetCellCenter(Cell)));
+		};
 
-	// If goal node is occupied by dynamic actors, also try to relocate it
-	if (!HasGoalFinalized && IsActorOverlapping(
-		InDetectionRadius,
-		InDetectionHalfHeight,
-		InActor,
-		ConvertGridCoordinatesToWorldLocation(GoalNode->Coordinates),
-		InObjectTypes,
-		InActorClassFilter))
+	// -------------------------------------------------------
+	// Path cache: a repeated query skips goal relocation and A*.
+	// Physics overlaps and leaf paths are not cached.
+	// -------------------------------------------------------
+	const bool bUseCache = PathCache.IsInitialized() && !OverlapQuery && !UsesSparseVoxelGraph();
+	FNavPathCacheKey CacheKey;
+	if (bUseCache)
 	{
-		if (NavNode* NewGoal = FindNearestFreeNode(
-			GoalNode,
-			InActor,
-			InObjectTypes,
-			InActorClassFilter,
-			InDetectionRadius,
-			InDetectionHalfHeight))
+		CacheKey.StartCell = StartNode;
+		CacheKey.GoalCell = GoalNode;
+		CacheKey.RequiredClearance = RequiredClearance;
+		static_assert(ObjectTypeQuery_MAX < 64, "FNavPathCacheKey::ObjectTypeMask needs a bit per object type");
+		for (const TEnumAsByte<EObjectTypeQuery>& ObjectType : InObjectTypes)
 		{
-			GoalNode = NewGoal;
+			CacheKey.ObjectTypeMask |= uint64(1) << FMath::Min<int32>(ObjectType.GetValue(), 63);
 		}
-		else
+
+		if (const TArray<int32>* CachedPath = PathCache.Find(CacheKey))
 		{
-			if (GEngine)
-			{
-				GEngine->AddOnScreenDebugMessage(
-					-1, 5.f, FColor::Red,
-					TEXT("No free goal node found near destination"));
-			}
-			return false;
+			SearchContext.PathNodes = *CachedPath;
+			OutGoalLocation = (CachedPath->Last() == GoalNode) ? InDestination : NavGrid->GetCellCenter(CachedPath->Last());
+			return true;
 		}
 	}
 
 	// -------------------------------------------------------
-	// A* Setup
+	// Connected components: a goal outside every component the start can
+	// enter is sealed off, which A* would only find out after expanding
+	// everything reachable. Dynamic obstacles can only cut paths further.
 	// -------------------------------------------------------
-	std::priority_queue<NavNode*, std::vector<NavNode*>, NavNodeCompare> OpenSet;
-	std::unordered_map<NavNode*, NavNode*> CameFrom;
-	std::unordered_map<NavNode*, float> GScores;
-	std::unordered_set<NavNode*> Visited;
-
-	// Heuristic: Euclidean distance in grid space
-	auto GetHeuristic = [&GoalNode](NavNode* InNode)
+	const FNavComponentLabels* Labels = (UsesComponentLabels() && !UsesSparseVoxelGraph())
+		? &FindOrBuildComponentLabels(RequiredClearance)
+		: nullptr;
+	FNavComponentLabels::FComponentList StartComponents;
+	if (Labels)
+	{
+		Labels->GetComponentsFrom(*NavGrid, StartNode, StartComponents);
+	}
+	auto IsInStartComponent = [Labels, &StartComponents](int32 Cell)
 		{
-			return FVector::Distance(FVector(InNode->Coordinates), FVector(GoalNode->Coordinates));
+			return StartComponents.Contains(Labels->GetLabel(Cell));
 		};
 
-	// Actual edge cost: Euclidean distance between neighbour cells
-	auto GetDistance = [](NavNode* FromNode, NavNode* ToNode)
-		{
-			return FVector::Distance(FVector(FromNode->Coordinates), FVector(ToNode->Coordinates));
-		};
+	// A goal in the start cell is always reached, even from a start enclosed on every side
+	const bool bGoalSealedOff = Labels && GoalNode != StartNode
+		&& (StartComponents.Num() == 0 || (NavGrid->IsPassable(GoalNode, RequiredClearance) && !IsInStartComponent(GoalNode)));
+	if (bGoalSealedOff)
+	{
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Verbose, TEXT("OctNavVolume3D:: Goal is not connected to the start; no search run."));
+#endif
+		return false;
+	}
 
-	// Safe accessor for g-scores (defaults to "infinite" if not set)
-	auto GetGScore = [&GScores](NavNode* InNode)
+	// -------------------------------------------------------
+	// Snap goal to nearest free node if original goal is blocked
+	// (by static geometry via the clearance field and/or dynamic obstacles),
+	// within GoalSearchRadius cells. With component labels, only cells the
+	// start can reach qualify.
+	// -------------------------------------------------------
+	const bool bGoalBlocked = !NavGrid->IsPassable(GoalNode, RequiredClearance)
+		|| (bFilterCells && !IsCellFree(GoalNode));
+
+	OutGoalLocation = InDestination;
+	if (bGoalBlocked)
+	{
+		// Bits (occupancy, components) are read for every cell in range; physics overlaps
+		// only confirm the nearest candidates, normally just one
+		auto IsCandidate = [Occupancy, IgnoredObstacleSlot, RequiredClearance, Labels, &IsInStartComponent](int32 Cell)
+			{
+				return !(Occupancy && Occupancy->IsOccupiedAround(Cell, RequiredClearance, IgnoredObstacleSlot))
+					&& (!Labels || IsInStartComponent(Cell));
+			};
+		auto IsConfirmed = [this, OverlapQuery](int32 Cell)
+			{
+				return !OverlapQuery || !IsActorOverlapping(*OverlapQuery, NavGrid->GetCellCenter(Cell));
+			};
+		const int32 NewGoal = FNavPathfinder::FindNearestFreeNode(*NavGrid, GoalNode, RequiredClearance, IsCandidate, GoalSearchRadius, IsConfirmed);
+
+		if (NewGoal != INDEX_NONE)
+		{
+			GoalNode = NewGoal;
+			OutGoalLocation = NavGrid->GetCellCenter(GoalNode);
+		}
+		else
 		{
-			auto It = GScores.find(InNode);
-			if (It != GScores.end())
+			if (GEngine)
 			{
-				return It->second;
+				GEngine->AddOnScreenDebugMessage(
+					-1, 5.f, FColor::Red,
+					TEXT("No free goal node found near destination"));
 			}
-			return FLT_MAX;
-		};
-
-	// Initialize start node
-	StartNode->FScore = GetHeuristic(StartNode);
-	OpenSet.push(StartNode);
-	GScores[StartNode] = 0.0f;
+			return false;
+		}
+	}
 
 	// -------------------------------------------------------
-	// A* Main Loop
+	// Sparse voxel mode: A* over the free octree leaves instead
 	// -------------------------------------------------------
-	while (!OpenSet.empty())
+	if (UsesSparseVoxelGraph())
 	{
-		NavNode* CurrentNavNode = OpenSet.top();
-		OpenSet.pop();
-		Visited.insert(CurrentNavNode);
+		return FindSparseVoxelPathNodes(InStart, OutGoalLocation, InDetectionRadius, OverlapQuery, IgnoredObstacleSlot);
+	}
 
-		// Goal reached: reconstruct path
-		if (CurrentNavNode == GoalNode)
+	// -------------------------------------------------------
+	// A* (jump point search, Theta*, bidirectional) over the baked grid
+	// -------------------------------------------------------
+	// All per-query state lives in the reusable SearchContext, so no containers are allocated here.
+	FNavPathQuery Query;
+	Query.StartNode = StartNode;
+	Query.GoalNode = GoalNode;
+	Query.RequiredClearance = RequiredClearance;
+	Query.bUseJumpPoints = (SearchMode == ENavSearchMode::ENSM_JumpPoint);
+	Query.bAnyAngle = (SearchMode == ENavSearchMode::ENSM_AnyAngle);
+	Query.bSmoothPath = bSmoothPaths;
+
+	bool bFound = false;
+	if (SearchMode == ENavSearchMode::ENSM_Bidirectional)
+	{
+		// Both directions check the cell filter themselves
+		bFound = bFilterCells
+			? FNavPathfinder::FindBidirectionalPath(*NavGrid, SearchContext, BackwardSearchContext, Query, IsCellFree)
+			: FNavPathfinder::FindBidirectionalPath(*NavGrid, SearchContext, BackwardSearchContext, Query);
+	}
+	else if (bFilterCells)
+	{
+		// Check dynamic obstacles for cells that improve the path (A* or Theta*: the
+		// hierarchical graph and jump point search only know the baked grid)
+		bFound = FNavPathfinder::FindPath(*NavGrid, SearchContext, Query, IsCellFree);
+	}
+	else if (SearchMode == ENavSearchMode::ENSM_Hierarchical)
+	{
+		// Coarse plan over cluster transitions, refined inside the clusters along it
+		bFound = FindOrBuildClusterGraph(RequiredClearance).FindPath(*NavGrid, SearchContext, StartNode, GoalNode);
+		if (bFound && bSmoothPaths)
 		{
-			OutPath.Add(ConvertGridCoordinatesToWorldLocation(CurrentNavNode->Coordinates));
+			FNavPathfinder::SmoothPath(*NavGrid, SearchContext.PathNodes, RequiredClearance);
+		}
+	}
+	else
+	{
+		bFound = FNavPathfinder::FindPath(*NavGrid, SearchContext, Query);
+	}
 
-			while (CameFrom.contains(CurrentNavNode))
+	// A path may come within reach of the querying actor's own obstacle cells, which other agents must avoid
+	const bool bCrossesOwnCells = Occupancy && IgnoredObstacleSlot != INDEX_NONE
+		&& SearchContext.PathNodes.ContainsByPredicate([Occupancy, RequiredClearance](int32 Cell)
 			{
-				OutPath.Insert(
-					ConvertGridCoordinatesToWorldLocation(CurrentNavNode->Coordinates),
-					0);
-				CurrentNavNode = CameFrom[CurrentNavNode];
-			}
+				return Occupancy->IsOccupiedAround(Cell, RequiredClearance, INDEX_NONE);
+			});
+	if (bFound && bUseCache && !bCrossesOwnCells)
+	{
+		PathCache.Add(CacheKey, *NavGrid, SearchContext.PathNodes);
+	}
 
-			OutPath.Insert(ConvertGridCoordinatesToWorldLocation(StartNode->Coordinates), 0);
-			return true;
-		}
+	LogSearchStats();
+	return bFound;
+}
 
-		const float CurrentGScore = GetGScore(CurrentNavNode);
+const FNavComponentLabels& AOctNavVolume3D::FindOrBuildComponentLabels(int32 RequiredClearance)
+{
+	FNavComponentLabels& Labels = ComponentLabels.FindOrAdd(RequiredClearance);
+	if (!Labels.IsBuilt())
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Labels.Build(*NavGrid, RequiredClearance);
 
-		// Evaluate neighbours
-		for (NavNode* Neighbour : CurrentNavNode->Neighbours)
-		{
-			const FVector NeighbourWorldPos = ConvertGridCoordinatesToWorldLocation(Neighbour->Coordinates);
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Log, TEXT("OctNavVolume3D:: Component labels for clearance %d built in %.2f ms (%d components)."),
+			RequiredClearance,
+			(FPlatformTime::Seconds() - StartTime) * 1000.0,
+			Labels.GetNumComponents());
+#endif
+	}
+	return Labels;
+}
 
-			// Skip neighbours blocked by octree
-			if (OctreeRoot && QueryPointBlocked(NeighbourWorldPos))
+bool AOctNavVolume3D::AreLocationsConnected(const FVector& InStart, const FVector& InDestination, float InDetectionRadius /*= 34.f*/, float InDetectionHalfHeight /*= 44.f */)
+{
+	const int32 StartNode = GetNode(ConvertWorldLocationToGridCoordinates(InStart));
+	const int32 GoalNode = GetNode(ConvertWorldLocationToGridCoordinates(InDestination));
+	if (StartNode == INDEX_NONE || GoalNode == INDEX_NONE)
+	{
+		return false;
+	}
+
+	const int32 RequiredClearance = NavGrid->HasClearanceLayer()
+		? NavGrid->GetRequiredClearance(InDetectionRadius, InDetectionHalfHeight)
+		: 1;
+	return FindOrBuildComponentLabels(RequiredClearance).AreConnected(*NavGrid, StartNode, GoalNode);
+}
+
+FNavClusterGraph& AOctNavVolume3D::FindOrBuildClusterGraph(int32 RequiredClearance)
+{
+	FNavClusterGraph& ClusterGraph = ClusterGraphs.FindOrAdd(RequiredClearance);
+	if (!ClusterGraph.IsBuilt())
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		ClusterGraph.Build(*NavGrid, HierarchicalClusterSize, RequiredClearance, SearchContext);
+
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Log, TEXT("OctNavVolume3D:: Hierarchical graph for clearance %d built in %.2f ms (%d nodes, %d links)."),
+			RequiredClearance,
+			(FPlatformTime::Seconds() - StartTime) * 1000.0,
+			ClusterGraph.GetNumNodes(),
+			ClusterGraph.GetNumLinks());
+#endif
+	}
+	return ClusterGraph;
+}
+
+bool AOctNavVolume3D::FindSparseVoxelPathNodes(
+	const FVector& InStart,
+	const FVector& InGoalLocation,
+	float InDetectionRadius,
+	const FNavOverlapQuery* InOverlapQuery,
+	int32 InIgnoredObstacleSlot)
+{
+	// Locate the free leaf containing a location. A location inside a blocked leaf (e.g. a start
+	// touching geometry) moves to the nearest free cell; grid cells and leaves share one
+	// containment rule, so a free cell center always lies in a free leaf.
+	auto FindFreeLeaf = [this](const FVector& WorldLocation)
+		{
+			const int32 Node = SparseVoxelGraph.FindNode(Octree, WorldLocation);
+			if (Node != INDEX_NONE)
 			{
-				continue;
+				return Node;
 			}
 
-			const float TentativeG = CurrentGScore + GetDistance(CurrentNavNode, Neighbour);
-			const float ExistingScore = GetGScore(Neighbour);
+			const int32 FreeCell = FNavPathfinder::FindNearestFreeNode(*NavGrid, GetNode(ConvertWorldLocationToGridCoordinates(WorldLocation)), 1, FNavPathfinder::FAcceptAllCells(), GoalSearchRadius);
+			return FreeCell != INDEX_NONE ? SparseVoxelGraph.FindNode(Octree, NavGrid->GetCellCenter(FreeCell)) : INDEX_NONE;
+		};
 
-			// Found a cheaper path to this neighbour
-			if (TentativeG < ExistingScore)
+	const int32 StartNode = FindFreeLeaf(InStart);
+	const int32 GoalNode = FindFreeLeaf(InGoalLocation);
+
+	if (StartNode == INDEX_NONE || GoalNode == INDEX_NONE)
+	{
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Warning, TEXT("Start or End leaf not found"));
+#endif
+		return false;
+	}
+
+	// The agent passes a shared face only if the face's smaller side fits the capsule diameter
+	const FNavSparseVoxelGraph::FSearchGraph Graph(SparseVoxelGraph, GoalNode, 2.0f * InDetectionRadius);
+
+	// A leaf is rejected if a mover covers any of its cells; dynamic overlaps are tested at the leaf centers
+	const FNavOccupancyLayer* Occupancy = GetActiveOccupancy();
+
+	bool bFound = false;
+	if (Occupancy || InOverlapQuery)
+	{
+		bFound = FNavPathfinder::FindGraphPath(Graph, SearchContext, StartNode, GoalNode, nullptr, [this, Occupancy, InIgnoredObstacleSlot, InOverlapQuery](int32 Node)
 			{
-				// Check dynamic overlaps (e.g., other actors or obstacles)
-				if (IsActorOverlapping(
-					InDetectionRadius,
-					InDetectionHalfHeight,
-					InActor,
-					NeighbourWorldPos,
-					InObjectTypes,
-					InActorClassFilter))
+				FIntVector MinCell, MaxCell;
+				if (Occupancy && NavGrid->GetCellRangeInBox(SparseVoxelGraph.GetBounds(Node), MinCell, MaxCell)
+					&& Occupancy->IsRangeOccupied(MinCell, MaxCell, InIgnoredObstacleSlot))
 				{
-					continue;
+					return false;
 				}
+				return !(InOverlapQuery && IsActorOverlapping(*InOverlapQuery, SparseVoxelGraph.GetCenter(Node)));
+			});
+	}
+	else
+	{
+		bFound = FNavPathfinder::FindGraphPath(Graph, SearchContext, StartNode, GoalNode);
+	}
 
-				CameFrom[Neighbour] = CurrentNavNode;
-				GScores[Neighbour] = TentativeG;
+	LogSearchStats();
+	return bFound;
+}
 
-				Neighbour->FScore = TentativeG + GetHeuristic(Neighbour);
+//
+// ============================================================================
+// Asynchronous Pathfinding
+// ============================================================================
+//
 
-				if (!Visited.contains(Neighbour))
-				{
-					OpenSet.push(Neighbour);
-				}
-			}
+int32 AOctNavVolume3D::RequestPathAsync(
+	const FVector& InStart,
+	const FVector& InDestination,
+	const FOnNavPathRequestComplete& OnComplete,
+	EPathRequestPriority InPriority /*= EPathRequestPriority::EPRP_Normal */,
+	float InDetectionRadius /*= 34.f*/,
+	float InDetectionHalfHeight /*= 44.f */,
+	AActor* InActor /*= nullptr */)
+{
+	if (!NavGrid->IsInitialized())
+	{
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D:: Async path requested before the grid was built."));
+#endif
+		return INDEX_NONE;
+	}
+
+	// Workers only see the grid, so agent size is expressed as a clearance requirement up front
+	const int32 RequiredClearance = NavGrid->HasClearanceLayer()
+		? NavGrid->GetRequiredClearance(InDetectionRadius, InDetectionHalfHeight)
+		: 1;
+
+	FNavPathQuery Options;
+	Options.RequiredClearance = RequiredClearance;
+	Options.bUseJumpPoints = (SearchMode == ENavSearchMode::ENSM_JumpPoint);
+	Options.bAnyAngle = (SearchMode == ENavSearchMode::ENSM_AnyAngle);
+	Options.bSmoothPath = bSmoothPaths;
+	Options.GoalSearchRadius = GoalSearchRadius;
+
+	const int32 RequestId = AsyncPathService.AddRequest(InStart, InDestination, Options, InPriority, FindDynamicObstacleSlot(InActor));
+	AsyncPathCallbacks.Add(RequestId, OnComplete);
+
+	// Start right away if a worker slot is free instead of waiting for the next tick
+	AsyncPathService.Dispatch(NavGrid, DynamicOccupancy, MaxConcurrentAsyncSearches);
+	return RequestId;
+}
+
+bool AOctNavVolume3D::CancelPathRequest(int32 RequestId)
+{
+	AsyncPathCallbacks.Remove(RequestId);
+	return AsyncPathService.CancelRequest(RequestId);
+}
+
+void AOctNavVolume3D::DeliverAsyncPathResults()
+{
+	FNavAsyncPathResult Result;
+	for (int32 Delivered = 0; Delivered < MaxAsyncResultsPerFrame && AsyncPathService.PopResult(Result); ++Delivered)
+	{
+		FOnNavPathRequestComplete Callback;
+		if (AsyncPathCallbacks.RemoveAndCopyValue(Result.RequestId, Callback))
+		{
+			// Callbacks may issue new requests or cancel others; both are safe here
+			Callback.ExecuteIfBound(Result.RequestId, Result.bSuccess, Result.Path);
+		}
+	}
+}
+
+void AOctNavVolume3D::LogSearchStats() const
+{
+#if WITH_EDITOR
+	UE_LOG(LogTemp, Verbose,
+		TEXT("OctNavVolume3D:: A* expanded %d nodes (heap: %d pushes, %d pops, %d decrease-keys)."),
+		SearchContext.NumExpanded,
+		SearchContext.OpenSet.NumPushes,
+		SearchContext.OpenSet.NumPops,
+		SearchContext.OpenSet.NumDecreaseKeys);
+#endif
+}
+
+//
+// ============================================================================
+// Time-Sliced Pathfinding
+// ============================================================================
+//
+
+int32 AOctNavVolume3D::RequestPathSliced(
+	const FVector& InStart,
+	const FVector& InDestination,
+	const FOnNavPathRequestComplete& OnComplete,
+	float InDetectionRadius /*= 34.f*/,
+	float InDetectionHalfHeight /*= 44.f */,
+	AActor* InActor /*= nullptr */)
+{
+	if (!NavGrid->IsInitialized())
+	{
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D:: Sliced path requested before the grid was built."));
+#endif
+		return INDEX_NONE;
+	}
+
+	FNavPathQuery Options;
+	Options.RequiredClearance = NavGrid->HasClearanceLayer()
+		? NavGrid->GetRequiredClearance(InDetectionRadius, InDetectionHalfHeight)
+		: 1;
+	Options.bUseJumpPoints = (SearchMode == ENavSearchMode::ENSM_JumpPoint);
+	Options.bAnyAngle = (SearchMode == ENavSearchMode::ENSM_AnyAngle);
+	Options.bSmoothPath = bSmoothPaths;
+	Options.GoalSearchRadius = GoalSearchRadius;
+
+	const int32 RequestId = SlicedPathService.AddRequest(InStart, InDestination, Options, FindDynamicObstacleSlot(InActor));
+	SlicedPathCallbacks.Add(RequestId, OnComplete);
+	return RequestId;
+}
+
+bool AOctNavVolume3D::CancelSlicedPathRequest(int32 RequestId)
+{
+	SlicedPathCallbacks.Remove(RequestId);
+	return SlicedPathService.CancelRequest(RequestId);
+}
+
+void AOctNavVolume3D::UpdateSlicedPathRequests()
+{
+	if (SlicedPathService.GetNumOutstanding() > 0)
+	{
+		SCOPE_CYCLE_COUNTER(STAT_SimpleNav3D_SlicedSearches);
+		SlicedPathService.Tick(NavGrid, GetActiveOccupancy(), SlicedSearchBudgetMs * 0.001, SlicedSearchExpansionsPerTick, MaxConcurrentSlicedSearches);
+	}
+
+	FNavAsyncPathResult Result;
+	while (SlicedPathService.PopResult(Result))
+	{
+		FOnNavPathRequestComplete Callback;
+		if (SlicedPathCallbacks.RemoveAndCopyValue(Result.RequestId, Callback))
+		{
+			// Callbacks may issue new requests (started next tick) or cancel others
+			Callback.ExecuteIfBound(Result.RequestId, Result.bSuccess, Result.Path);
 		}
 	}
+}
+
+//
+// ============================================================================
+// Batch Pathfinding
+// ============================================================================
+//
+
+int32 AOctNavVolume3D::FindPathsBatch(const TArray<FNavBatchPathQuery>& InQueries, TArray<FNavBatchPathResult>& OutResults)
+{
+	if (!NavGrid->IsInitialized())
+	{
+#if WITH_EDITOR
+		UE_LOG(LogTemp, Warning, TEXT("OctNavVolume3D:: Path batch requested before the grid was built."));
+#endif
+		OutResults.Reset();
+		OutResults.SetNum(InQueries.Num());
+		return 0;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_SimpleNav3D_BatchSearches);
+
+	// Actors and settings are resolved here on the game thread; workers only see the grid
+	const bool bHasClearanceLayer = NavGrid->HasClearanceLayer();
+	TArray<FNavBatchPathRequest> Requests;
+	Requests.SetNum(InQueries.Num());
+	for (int32 QueryIndex = 0; QueryIndex < InQueries.Num(); ++QueryIndex)
+	{
+		const FNavBatchPathQuery& Query = InQueries[QueryIndex];
+		FNavBatchPathRequest& Request = Requests[QueryIndex];
+		Request.Start = Query.Start;
+		Request.Destination = Query.Destination;
+		Request.Options.RequiredClearance = bHasClearanceLayer
+			? NavGrid->GetRequiredClearance(Query.DetectionRadius, Query.DetectionHalfHeight)
+			: 1;
+		Request.Options.bUseJumpPoints = (SearchMode == ENavSearchMode::ENSM_JumpPoint);
+		Request.Options.bAnyAngle = (SearchMode == ENavSearchMode::ENSM_AnyAngle);
+		Request.Options.bSmoothPath = bSmoothPaths;
+		Request.Options.GoalSearchRadius = GoalSearchRadius;
+		Request.IgnoredObstacleSlot = FindDynamicObstacleSlot(Query.Actor);
+	}
+
+	return BatchPathService.Run(*NavGrid, GetActiveOccupancy(), Requests, OutResults, bParallelBatchPathfinding);
+}
+
+//
+// ============================================================================
+// Incremental Replanning
+// ============================================================================
+//
+
+int32 AOctNavVolume3D::CreateIncrementalPlanner(float InDetectionRadius /*= 34.f*/, float InDetectionHalfHeight /*= 44.f*/, AActor* InAgent /*= nullptr*/)
+{
+	const int32 PlannerId = NextIncrementalPlannerId++;
+	FNavIncrementalPlannerEntry& Entry = IncrementalPlanners.Add(PlannerId);
+	Entry.DetectionRadius = InDetectionRadius;
+	Entry.DetectionHalfHeight = InDetectionHalfHeight;
+	Entry.Agent = InAgent;
+	return PlannerId;
+}
+
+bool AOctNavVolume3D::UpdateIncrementalPlanner(int32 PlannerId, const FVector& InStart, const FVector& InDestination, TArray<FVector>& OutPath)
+{
+	OutPath.Reset();
+
+	FNavIncrementalPlannerEntry* Entry = IncrementalPlanners.Find(PlannerId);
+	if (!Entry || !NavGrid->IsInitialized())
+	{
+		return false;
+	}
+
+	const int32 StartNode = GetNode(ConvertWorldLocationToGridCoordinates(InStart));
+	int32 GoalNode = GetNode(ConvertWorldLocationToGridCoordinates(InDestination));
+	if (StartNode == INDEX_NONE || GoalNode == INDEX_NONE)
+	{
+		return false;
+	}
 
-	// No path found
-	return false;
+	SCOPE_CYCLE_COUNTER(STAT_SimpleNav3D_IncrementalReplans);
+
+	// Resolved on every update: the clearance layer and the agent's obstacle slot may appear after creation
+	const int32 RequiredClearance = NavGrid->HasClearanceLayer()
+		? NavGrid->GetRequiredClearance(Entry->DetectionRadius, Entry->DetectionHalfHeight)
+		: 1;
+	FNavIncrementalPlanner& Planner = Entry->Planner;
+	if (Planner.GetRequiredClearance() != RequiredClearance)
+	{
+		Planner.Init(RequiredClearance);
+	}
+
+	const FNavOccupancyLayer* Occupancy = GetActiveOccupancy();
+	const int32 IgnoredObstacleSlot = FindDynamicObstacleSlot(Entry->Agent.Get());
+	auto IsCellFree = [Occupancy, IgnoredObstacleSlot, RequiredClearance](int32 Cell)
+		{
+			return !(Occupancy && Occupancy->IsOccupiedAround(Cell, RequiredClearance, IgnoredObstacleSlot));
+		};
+
+	// A goal inside geometry or another obstacle moves to the nearest cell the agent fits in
+	if (!NavGrid->IsPassable(GoalNode, RequiredClearance) || !IsCellFree(GoalNode))
+	{
+		GoalNode = FNavPathfinder::FindNearestFreeNode(*NavGrid, GoalNode, RequiredClearance, IsCellFree, GoalSearchRadius);
+		if (GoalNode == INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	// A sealed-off goal would make the planner exhaust the start's component on every update
+	if (UsesComponentLabels() && !FindOrBuildComponentLabels(RequiredClearance).AreConnected(*NavGrid, StartNode, GoalNode))
+	{
+		return false;
+	}
+
+	if (!Planner.Plan(*NavGrid, Occupancy, StartNode, GoalNode, IgnoredObstacleSlot))
+	{
+		return false;
+	}
+
+	// The planner's own path stays a walk over its tree; smoothing works on a copy
+	const TArray<int32>* PathNodes = &Planner.GetPathNodes();
+	TArray<int32> SmoothedPathNodes;
+	if (bSmoothPaths)
+	{
+		SmoothedPathNodes = *PathNodes;
+		FNavPathfinder::SmoothPath(*NavGrid, SmoothedPathNodes, RequiredClearance, IsCellFree);
+		PathNodes = &SmoothedPathNodes;
+	}
+
+	OutPath.Reserve(PathNodes->Num());
+	for (const int32 Node : *PathNodes)
+	{
+		OutPath.Add(NavGrid->GetCellCenter(Node));
+	}
+	return true;
+}
+
+void AOctNavVolume3D::DestroyIncrementalPlanner(int32 PlannerId)
+{
+	IncrementalPlanners.Remove(PlannerId);
+}
+
+void AOctNavVolume3D::NotifyIncrementalPlanners(const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	for (TPair<int32, FNavIncrementalPlannerEntry>& Pair : IncrementalPlanners)
+	{
+		Pair.Value.Planner.NotifyCellsChanged(MinCell, MaxCell);
+	}
+}
+
+//
+// ============================================================================
+// Path Cache
+// ============================================================================
+//
+
+void AOctNavVolume3D::GetPathCacheStats(int64& OutHits, int64& OutMisses, int32& OutNumEntries) const
+{
+	OutHits = PathCache.GetNumHits();
+	OutMisses = PathCache.GetNumMisses();
+	OutNumEntries = PathCache.Num();
+}
+
+void AOctNavVolume3D::ResetPathCacheStats()
+{
+	PathCache.ResetStats();
+}
+
+void AOctNavVolume3D::ClearPathCache()
+{
+	PathCache.Empty();
+}
+
+void AOctNavVolume3D::InvalidatePathCache(const FIntVector& MinCell, const FIntVector& MaxCell)
+{
+	const FIntVector Padding(NavGrid->HasClearanceLayer() ? NavGrid->GetMaxClearance() : 0);
+	PathCache.InvalidateCells(MinCell - Padding, MaxCell + Padding);
+}
+
+//
+// ============================================================================
+// Flow Field
+// ============================================================================
+//
+
+void AOctNavVolume3D::SetFlowFieldGoal(const FVector& InGoal, float InDetectionRadius /*= 34.f*/, float InDetectionHalfHeight /*= 44.f*/, float InMaxDistance /*= 0.f*/)
+{
+	if (!NavGrid->IsInitialized())
+	{
+		return;
+	}
+
+	const int32 RequiredClearance = NavGrid->HasClearanceLayer()
+		? NavGrid->GetRequiredClearance(InDetectionRadius, InDetectionHalfHeight)
+		: 1;
+	const float MaxCost = FMath::Max(InMaxDistance, 0.0f) / DivisionSize;
+
+	int32 GoalCell = GetNode(ConvertWorldLocationToGridCoordinates(InGoal));
+	if (!NavGrid->IsPassable(GoalCell, RequiredClearance))
+	{
+		GoalCell = FNavPathfinder::FindNearestFreeNode(*NavGrid, GoalCell, RequiredClearance, FNavPathfinder::FAcceptAllCells(), GoalSearchRadius);
+		if (GoalCell == INDEX_NONE)
+		{
+			return;
+		}
+	}
+
+	// Built from Tick; most calls come from a goal still inside the same cell and change nothing
+	FlowFieldGoalCell = GoalCell;
+	FlowFieldRequiredClearance = RequiredClearance;
+	FlowFieldMaxCost = MaxCost;
+}
+
+void AOctNavVolume3D::ClearFlowField()
+{
+	FlowField.Reset();
+	PendingFlowField.Reset();
+	bFlowFieldPending = false;
+	FlowFieldGoalCell = INDEX_NONE;
+	bFlowFieldGridChanged = false;
+}
+
+bool AOctNavVolume3D::GetFlowFieldNextLocation(const FVector& InLocation, FVector& OutNextLocation)
+{
+	if (!FlowField.IsComplete())
+	{
+		return false;
+	}
+
+	const int32 Cell = GetNode(ConvertWorldLocationToGridCoordinates(InLocation));
+	if (Cell == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (Cell == FlowField.GetGoalCell())
+	{
+		OutNextLocation = NavGrid->GetCellCenter(Cell);
+		return true;
+	}
+
+	// An agent outside the field (pushed into a wall, or in a cell too narrow for it) steps back in
+	const int32 NextCell = FlowField.IsSettled(Cell) ? FlowField.GetNextCell(Cell) : FlowField.FindBestNeighbour(*NavGrid, Cell);
+	if (NextCell == INDEX_NONE)
+	{
+		return false;
+	}
+
+	OutNextLocation = NavGrid->GetCellCenter(NextCell);
+	return true;
+}
+
+float AOctNavVolume3D::GetFlowFieldDistance(const FVector& InLocation)
+{
+	const int32 Cell = GetNode(ConvertWorldLocationToGridCoordinates(InLocation));
+	if (Cell == INDEX_NONE || !FlowField.IsComplete() || !FlowField.IsSettled(Cell))
+	{
+		return -1.0f;
+	}
+	return FlowField.GetCost(Cell) * DivisionSize;
+}
+
+void AOctNavVolume3D::StepFlowField()
+{
+	if (!bFlowFieldPending)
+	{
+		// A rebuild in flight always finishes first, so a goal moving faster than a rebuild takes only
+		// delays the field instead of restarting it forever
+		const bool bFieldCurrent = FlowField.IsStarted()
+			&& FlowField.GetGoalCell() == FlowFieldGoalCell
+			&& FlowField.GetRequiredClearance() == FlowFieldRequiredClearance
+			&& FlowField.GetMaxCost() == FlowFieldMaxCost;
+		if (FlowFieldGoalCell == INDEX_NONE || (bFieldCurrent && !bFlowFieldGridChanged))
+		{
+			return;
+		}
+
+		PendingFlowField.Begin(*NavGrid, FlowFieldGoalCell, FlowFieldRequiredClearance, FlowFieldMaxCost);
+		bFlowFieldPending = true;
+		bFlowFieldGridChanged = false;
+	}
+
+	if (!PendingFlowField.Step(*NavGrid, FlowFieldExpansionsPerTick))
+	{
+		return;
+	}
+
+	// Publish; the old field's storage is reused by the next rebuild
+	Swap(FlowField, PendingFlowField);
+	bFlowFieldPending = false;
+
+#if WITH_EDITOR
+	UE_LOG(LogTemp, Verbose, TEXT("OctNavVolume3D:: Flow field toward cell %d settled %d cells."),
+		FlowField.GetGoalCell(),
+		FlowField.GetNumSettledCells());
+#endif
 }
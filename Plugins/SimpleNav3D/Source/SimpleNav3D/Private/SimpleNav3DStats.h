@@ -0,0 +1,6 @@
+#pragma once
+
+#include "Stats/Stats.h"
+
+/** Stat group for SimpleNav3D build and query costs ("stat SimpleNav3D"). */
+DECLARE_STATS_GROUP(TEXT("SimpleNav3D"), STATGROUP_SimpleNav3D, STATCAT_Advanced);
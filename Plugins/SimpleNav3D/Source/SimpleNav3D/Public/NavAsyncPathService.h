@@ -0,0 +1,144 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Deque.h"
+#include "Containers/Queue.h"
+#include "HAL/CriticalSection.h"
+#include "Tasks/Task.h"
+#include "NavGrid.h"
+#include "NavOccupancyLayer.h"
+#include "NavPathTypes.h"
+#include "NavPathfinder.h"
+#include "NavSearchContext.h"
+#include <atomic>
+
+/** Read-only grid shared with path workers. Kept alive by every search that uses it. */
+using FNavGridSnapshotPtr = TSharedPtr<const FNavGrid, ESPMode::ThreadSafe>;
+
+/** Read-only dynamic obstacle layer shared with path workers, like FNavGridSnapshotPtr. */
+using FNavOccupancySnapshotPtr = TSharedPtr<const FNavOccupancyLayer, ESPMode::ThreadSafe>;
+
+/**
+ * Result of an asynchronous path request, produced on a worker and consumed on the game thread.
+ */
+struct FNavAsyncPathResult
+{
+	/** Id returned by AddRequest. */
+	int32 RequestId = INDEX_NONE;
+
+	/** Whether a path was found. */
+	bool bSuccess = false;
+
+	/** Number of nodes A* expanded (for profiling). */
+	int32 NumExpanded = 0;
+
+	/** World-space cell centers of the path, start first. */
+	TArray<FVector> Path;
+};
+
+/**
+ * FNavAsyncPathService
+ *
+ * Runs path requests on worker threads (UE::Tasks) against an immutable FNavGrid snapshot.
+ * - Requests wait in per-priority FIFO queues; Dispatch launches the highest priority ones first,
+ *   up to a concurrency limit, so a burst of requests cannot saturate the task system.
+ * - Each worker borrows an FNavSearchContext from a pool, so steady-state searches do not allocate scratch.
+ * - Finished results go through a lock-free MPSC queue and are drained on the game thread by PopResult.
+ * - Cancellation is a flag polled by the search; cancelled requests produce no result.
+ * - Workers only consult the grid's clearance field and the dynamic obstacle layer:
+ *   physics overlap checks require the game thread.
+ *
+ * All public functions must be called from the game thread.
+ */
+class SIMPLENAV3D_API FNavAsyncPathService
+{
+public:
+	FNavAsyncPathService();
+
+	/** Cancels outstanding requests and waits for running workers. */
+	~FNavAsyncPathService();
+
+	/**
+	 * Queues a path request. It is launched by the next Dispatch call with a free slot.
+	 *
+	 * @param InStart             World-space start location.
+	 * @param InDestination       World-space goal location (relocated to the nearest free cell if needed).
+	 * @param Options             Clearance and search variant; start, goal and cancel flag are filled in by the worker.
+	 * @param Priority            Scheduling priority.
+	 * @param IgnoredObstacleSlot Dynamic obstacle slot of the requesting agent itself, or INDEX_NONE.
+	 *
+	 * @return Id identifying the request in results and CancelRequest.
+	 */
+	int32 AddRequest(const FVector& InStart, const FVector& InDestination, const FNavPathQuery& Options, EPathRequestPriority Priority, int32 IgnoredObstacleSlot = INDEX_NONE);
+
+	/**
+	 * Cancels a queued or running request. Its result will not be returned by PopResult.
+	 *
+	 * @return true if the request was still outstanding.
+	 */
+	bool CancelRequest(int32 RequestId);
+
+	/**
+	 * Launches queued requests on worker threads until MaxConcurrentSearches are running.
+	 *
+	 * @param Snapshot               Grid the launched searches run against.
+	 * @param Occupancy              Dynamic obstacles the launched searches avoid (may be null).
+	 * @param MaxConcurrentSearches  Upper bound on simultaneously running searches.
+	 */
+	void Dispatch(const FNavGridSnapshotPtr& Snapshot, const FNavOccupancySnapshotPtr& Occupancy, int32 MaxConcurrentSearches);
+
+	/** Retrieves the next finished, non-cancelled result. Returns false if none is ready. */
+	bool PopResult(FNavAsyncPathResult& OutResult);
+
+	/** Cancels all outstanding requests and blocks until every running worker has returned. */
+	void Shutdown();
+
+	/** Returns the number of requests that were neither cancelled nor popped as a result yet. */
+	FORCEINLINE int32 GetNumOutstanding() const { return Outstanding.Num(); }
+
+private:
+	/** A request as seen by both the game thread and its worker. */
+	struct FRequest
+	{
+		int32 RequestId = INDEX_NONE;
+		FVector Start = FVector::ZeroVector;
+		FVector Destination = FVector::ZeroVector;
+		FNavPathQuery Options;
+		int32 IgnoredObstacleSlot = INDEX_NONE;
+
+		/** Set by the game thread; polled by the worker. */
+		std::atomic<bool> bCancelled = false;
+	};
+
+	using FRequestPtr = TSharedPtr<FRequest, ESPMode::ThreadSafe>;
+
+	/** State shared with workers. Reference counted so it outlives the service while workers finish. */
+	struct FShared
+	{
+		/** Finished results, written by workers, read by the game thread. */
+		TQueue<FNavAsyncPathResult, EQueueMode::Mpsc> Results;
+
+		/** Search contexts not currently used by a worker. */
+		TArray<TUniquePtr<FNavSearchContext>> FreeContexts;
+		FCriticalSection FreeContextsLock;
+
+		TUniquePtr<FNavSearchContext> AcquireContext();
+		void ReleaseContext(TUniquePtr<FNavSearchContext> Context);
+	};
+
+	/** Worker entry point: resolves cells, relocates the goal, runs A* and posts the result. */
+	static void RunRequest(const FNavGrid& Grid, const FNavOccupancyLayer* Occupancy, const FRequest& Request, FShared& Shared);
+
+	/** Waiting requests, one FIFO per priority (indexed by EPathRequestPriority). */
+	TDeque<FRequestPtr> Queued[3];
+
+	/** Queued and launched requests by id, until their result is popped or they are cancelled. */
+	TMap<int32, FRequestPtr> Outstanding;
+
+	/** Tasks that may still be running. Pruned on Dispatch. */
+	TArray<UE::Tasks::FTask> RunningTasks;
+
+	TSharedRef<FShared, ESPMode::ThreadSafe> Shared;
+
+	int32 NextRequestId = 1;
+};
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "NavGrid.h"
+#include "NavOctree.h"
+#include "NavSparseVoxelGraph.h"
+#include "NavComponentLabels.h"
+#include "NavBakedDataVersion.h"
+#include "NavBakedData.generated.h"
+
+/**
+ * Volume settings baked navigation data depends on.
+ * A bake is only used when it was made with exactly the volume's current settings.
+ */
+struct FNavBakeSettings
+{
+	/** Grid size in cells. */
+	FIntVector GridSize = FIntVector::ZeroValue;
+
+	/** World-space minimum corner of the grid. */
+	FVector Origin = FVector::ZeroVector;
+
+	/** Side length of one cell. */
+	float CellSize = 0.0f;
+
+	/** Neighbour connectivity rule of the grid. */
+	int32 MinSharedNeighborAxes = 0;
+
+	/** Clearance cap, or 0 when the clearance field is disabled. */
+	int32 MaxClearanceCells = 0;
+
+	/** Octree split parameters. */
+	float OctreeMinCellSize = 0.0f;
+	int32 OctreeMaxDepth = 0;
+
+	/** Whether the grid uses brick storage. */
+	bool bBrickStorage = false;
+
+	bool operator==(const FNavBakeSettings& Other) const
+	{
+		return GridSize == Other.GridSize
+			&& Origin == Other.Origin
+			&& CellSize == Other.CellSize
+			&& MinSharedNeighborAxes == Other.MinSharedNeighborAxes
+			&& MaxClearanceCells == Other.MaxClearanceCells
+			&& OctreeMinCellSize == Other.OctreeMinCellSize
+			&& OctreeMaxDepth == Other.OctreeMaxDepth
+			&& bBrickStorage == Other.bBrickStorage;
+	}
+
+	bool operator!=(const FNavBakeSettings& Other) const { return !(*this == Other); }
+
+	friend FArchive& operator<<(FArchive& Ar, FNavBakeSettings& Settings)
+	{
+		Ar << Settings.GridSize << Settings.Origin << Settings.CellSize << Settings.MinSharedNeighborAxes;
+		Ar << Settings.MaxClearanceCells << Settings.OctreeMinCellSize << Settings.OctreeMaxDepth;
+		if (Ar.CustomVer(FNavBakedDataVersion::GUID) >= FNavBakedDataVersion::BrickStorage)
+		{
+			Ar << Settings.bBrickStorage;
+		}
+		return Ar;
+	}
+};
+
+/**
+ * UNavBakedData
+ *
+ * Navigation data of an AOctNavVolume3D baked in the editor, so BeginPlay does not rebuild it.
+ * - Holds the grid (blocked bits and clearance field), the classified octree and, if the volume
+ *   searched it when baked, the sparse voxel graph and the component labels of the smallest agent size class.
+ * - Stored as compact versioned binary (FNavBakedDataVersion); flat arrays are bulk-serialized.
+ * - The grid is shared with every volume using the asset and must be treated as immutable:
+ *   region rebuilds already work on a copy.
+ */
+UCLASS(BlueprintType)
+class SIMPLENAV3D_API UNavBakedData : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	//~ Begin UObject Interface
+	virtual void Serialize(FArchive& Ar) override;
+	//~ End UObject Interface
+
+	/** Returns true if the asset holds baked data. */
+	FORCEINLINE bool HasData() const { return bHasData; }
+
+	/** Returns true if the asset holds data baked with exactly these settings. */
+	FORCEINLINE bool Matches(const FNavBakeSettings& InSettings) const { return bHasData && Settings == InSettings; }
+
+	/** Returns the baked grid (shared, read-only by convention). */
+	FORCEINLINE TSharedRef<FNavGrid, ESPMode::ThreadSafe> GetGrid() const { return Grid; }
+
+	/** Returns the baked octree. */
+	FORCEINLINE const FNavOctree& GetOctree() const { return Octree; }
+
+	/** Returns true if the sparse voxel graph was baked. */
+	FORCEINLINE bool HasSparseVoxelGraph() const { return bHasSparseVoxelGraph; }
+
+	/** Returns the baked sparse voxel graph (empty unless HasSparseVoxelGraph). */
+	FORCEINLINE const FNavSparseVoxelGraph& GetSparseVoxelGraph() const { return SparseVoxelGraph; }
+
+	/** Returns true if component labels were baked. */
+	FORCEINLINE bool HasComponentLabels() const { return bHasComponentLabels; }
+
+	/** Returns the baked component labels (empty unless HasComponentLabels). */
+	FORCEINLINE const FNavComponentLabels& GetComponentLabels() const { return ComponentLabels; }
+
+#if WITH_EDITOR
+	/**
+	 * Replaces the asset contents with freshly built navigation data and marks the package dirty.
+	 *
+	 * @param InSettings          Volume settings the data was built with.
+	 * @param InGrid              Grid with blocked bits (and clearance field, if enabled).
+	 * @param InOctree            Classified, collapsed octree.
+	 * @param InSparseVoxelGraph  Optional sparse voxel graph built from InOctree.
+	 * @param InComponentLabels   Optional component labels built from InGrid.
+	 */
+	void Store(const FNavBakeSettings& InSettings, const FNavGrid& InGrid, const FNavOctree& InOctree, const FNavSparseVoxelGraph* InSparseVoxelGraph, const FNavComponentLabels* InComponentLabels);
+#endif
+
+private:
+	/** Drops all baked data. */
+	void ResetData();
+
+	/** Whether the asset holds baked data. */
+	bool bHasData = false;
+
+	/** Settings the data was baked with. */
+	FNavBakeSettings Settings;
+
+	/** Baked grid; a new instance is allocated on every load, so volumes using the old one keep it. */
+	TSharedRef<FNavGrid, ESPMode::ThreadSafe> Grid = MakeShared<FNavGrid, ESPMode::ThreadSafe>();
+
+	/** Baked octree. */
+	FNavOctree Octree;
+
+	/** Whether SparseVoxelGraph was baked. */
+	bool bHasSparseVoxelGraph = false;
+
+	/** Baked sparse voxel graph. */
+	FNavSparseVoxelGraph SparseVoxelGraph;
+
+	/** Whether ComponentLabels was baked. */
+	bool bHasComponentLabels = false;
+
+	/** Baked component labels. */
+	FNavComponentLabels ComponentLabels;
+};
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Custom serialization version of UNavBakedData.
+ * Add a value above VersionPlusOne whenever the binary layout changes, and branch on it when loading.
+ */
+struct SIMPLENAV3D_API FNavBakedDataVersion
+{
+	enum Type
+	{
+		/** Grid, octree and optional sparse voxel graph. */
+		InitialVersion = 0,
+
+		/** Grid storage mode flag and brick-compressed grids. */
+		BrickStorage,
+
+		/** Run-length encoded component labels of the smallest agent size class. */
+		ComponentLabels,
+
+		// -----<new versions can be added above this line>-----
+		VersionPlusOne,
+		LatestVersion = VersionPlusOne - 1
+	};
+
+	/** Unique id of this custom version. */
+	static const FGuid GUID;
+};
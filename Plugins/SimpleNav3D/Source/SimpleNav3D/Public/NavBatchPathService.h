@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavPathTypes.h"
+#include "NavPathfinder.h"
+#include "NavSearchContext.h"
+
+struct FNavGrid;
+struct FNavOccupancyLayer;
+
+/**
+ * One resolved query of a path batch: agent size already turned into a clearance requirement.
+ */
+struct FNavBatchPathRequest
+{
+	FVector Start = FVector::ZeroVector;
+	FVector Destination = FVector::ZeroVector;
+
+	/** Clearance and search variant; start and goal are filled in by the search. */
+	FNavPathQuery Options;
+
+	/** Dynamic obstacle slot of the requesting agent itself, or INDEX_NONE. */
+	int32 IgnoredObstacleSlot = INDEX_NONE;
+};
+
+/**
+ * FNavBatchPathService
+ *
+ * Runs many path queries at once (e.g. a spawning wave) in parallel and waits for all of them.
+ * - Every worker owns one FNavSearchContext from a pool kept across batches, so batches do not allocate scratch.
+ * - Workers pull the next query from a shared counter: long searches do not hold up a fixed share of the batch.
+ * - The grid and obstacle layer are only read, so the caller must not change them until Run returns.
+ * - Queries see the same data as async requests: clearance field and dynamic obstacle layer, no physics overlaps.
+ *
+ * Results are written at the index of their query.
+ */
+class SIMPLENAV3D_API FNavBatchPathService
+{
+public:
+	/**
+	 * Searches every request and blocks until all are done.
+	 *
+	 * @param Grid        Grid to search.
+	 * @param Occupancy   Dynamic obstacles to avoid (may be null).
+	 * @param Requests    Queries to run.
+	 * @param OutResults  One result per request, same order (resized to match).
+	 * @param bParallel   Spread the queries over worker threads; false runs them on the calling thread.
+	 *
+	 * @return Number of queries that found a path.
+	 */
+	int32 Run(const FNavGrid& Grid, const FNavOccupancyLayer* Occupancy, TConstArrayView<FNavBatchPathRequest> Requests, TArray<FNavBatchPathResult>& OutResults, bool bParallel);
+
+	/** Releases the pooled search contexts. */
+	void Reset();
+
+private:
+	/** Resolves the cells of one request, relocates its goal and runs its search. */
+	static void RunRequest(const FNavGrid& Grid, const FNavOccupancyLayer* Occupancy, const FNavBatchPathRequest& Request, FNavSearchContext& Context, FNavBatchPathResult& OutResult);
+
+	/** One search context per worker of the last (largest) batch. */
+	TArray<TUniquePtr<FNavSearchContext>> Contexts;
+};
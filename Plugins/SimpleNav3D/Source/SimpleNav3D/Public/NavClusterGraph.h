@@ -0,0 +1,188 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavGrid.h"
+#include "NavSearchContext.h"
+#include <atomic>
+
+/**
+ * A crossing between two neighbouring clusters: a pair of adjacent free cells, one on each side.
+ */
+struct FNavClusterTransition
+{
+	/** Cell in the cluster the transition is stored with. */
+	int32 LowCell = INDEX_NONE;
+
+	/** Cell in the neighbouring cluster. */
+	int32 HighCell = INDEX_NONE;
+
+	/** Step cost between the two cells (1, sqrt(2) or sqrt(3)). */
+	float Cost = 0.0f;
+};
+
+/**
+ * FNavClusterGraph
+ *
+ * Hierarchical pathfinding (HPA*) over an FNavGrid for one clearance requirement.
+ * - The grid is split into fixed-size cubic clusters. Between every pair of neighbouring clusters,
+ *   each group of connected crossings gets one transition (a pair of adjacent cells).
+ * - Transition cells are the abstract nodes. Nodes of one cluster are linked by their precomputed
+ *   distance inside the cluster, transitions link nodes of neighbouring clusters.
+ * - A query links start and goal to the nodes of their clusters, runs A* on the abstract graph and
+ *   refines each abstract edge with A* restricted to one cluster, so only the corridor is searched at
+ *   cell level. Paths are near optimal (they pass through transition cells).
+ * - After grid changes, RebuildRegion recomputes only the clusters around the changed cells.
+ * - A start cell the agent does not fit in is only linked through its own cluster; if that finds
+ *   no path, the query falls back to a full grid search.
+ * - Owns query scratch state: one instance must not be queried from several threads at once.
+ */
+struct SIMPLENAV3D_API FNavClusterGraph
+{
+public:
+	/**
+	 * Builds transitions and intra-cluster distances for the whole grid.
+	 *
+	 * @param Grid                 Grid to abstract (blocked bits and clearance layer are read).
+	 * @param InClusterSize        Side length of a cluster in cells.
+	 * @param InRequiredClearance  Clearance every cell of an abstracted path must have.
+	 * @param Context              Scratch state for the intra-cluster searches.
+	 */
+	void Build(const FNavGrid& Grid, int32 InClusterSize, int32 InRequiredClearance, FNavSearchContext& Context);
+
+	/**
+	 * Updates the graph after the blocked bits of an inclusive cell range changed.
+	 * Only clusters within reach of the range (widened by the clearance cap) and their neighbours are recomputed.
+	 */
+	void RebuildRegion(const FNavGrid& Grid, const FIntVector& DirtyMin, const FIntVector& DirtyMax, FNavSearchContext& Context);
+
+	/** Releases all storage. */
+	void Reset();
+
+	/** Returns true once Build has been called. */
+	FORCEINLINE bool IsBuilt() const { return Clusters.Num() > 0; }
+
+	/** Returns the clearance the graph was built for. */
+	FORCEINLINE int32 GetRequiredClearance() const { return RequiredClearance; }
+
+	/** Returns the number of abstract nodes (transition cells). */
+	FORCEINLINE int32 GetNumNodes() const { return NodeCells.Num(); }
+
+	/** Returns the number of directed abstract links. */
+	FORCEINLINE int32 GetNumLinks() const { return Links.Num(); }
+
+	/**
+	 * Finds a path between two cells. On success the cells of the path (start first)
+	 * are left in Context.PathNodes and Context.NumExpanded holds the expansions of all levels.
+	 *
+	 * @param Grid        Grid the graph was built from.
+	 * @param Context     Scratch state for the cell-level searches.
+	 * @param StartCell   Linear index of the start cell.
+	 * @param GoalCell    Linear index of the goal cell.
+	 * @param CancelFlag  Optional flag polled during the abstract search.
+	 *
+	 * @return true if a path was found.
+	 */
+	bool FindPath(const FNavGrid& Grid, FNavSearchContext& Context, int32 StartCell, int32 GoalCell, const std::atomic<bool>* CancelFlag = nullptr);
+
+private:
+	/** An abstract link (intra-cluster distance or transition). */
+	struct FLink
+	{
+		int32 Node = INDEX_NONE;
+		float Cost = 0.0f;
+	};
+
+	/** Abstract nodes and intra-cluster distances of one cluster. */
+	struct FCluster
+	{
+		/** Transition cells in this cluster, sorted. */
+		TArray<int32> Cells;
+
+		/** Distance inside the cluster between Cells[I] and Cells[J] at [I * Cells.Num() + J] (MAX_flt if unreachable). */
+		TArray<float> Distances;
+	};
+
+	/** Abstract graph plus a query's start and goal, as seen by FNavPathfinder::FindGraphPath. */
+	struct FAbstractSearchGraph;
+
+	/** Number of neighbour directions stored per cluster (one of each opposite pair). */
+	static constexpr int32 NumPairDirections = 13;
+
+	/** Returns the cluster coordinates of a cell. */
+	FORCEINLINE FIntVector GetClusterCoordinates(const FIntVector& CellCoordinates) const
+	{
+		return FIntVector(CellCoordinates.X / ClusterSize, CellCoordinates.Y / ClusterSize, CellCoordinates.Z / ClusterSize);
+	}
+
+	/** Returns true if cluster coordinates are inside the cluster grid. */
+	FORCEINLINE bool IsValidCluster(const FIntVector& ClusterCoordinates) const
+	{
+		return ClusterCoordinates.X >= 0 && ClusterCoordinates.X < NumClusters.X
+			&& ClusterCoordinates.Y >= 0 && ClusterCoordinates.Y < NumClusters.Y
+			&& ClusterCoordinates.Z >= 0 && ClusterCoordinates.Z < NumClusters.Z;
+	}
+
+	/** Returns the linear index of a cluster. */
+	FORCEINLINE int32 GetClusterIndex(const FIntVector& ClusterCoordinates) const
+	{
+		return (ClusterCoordinates.Z * NumClusters.Y + ClusterCoordinates.Y) * NumClusters.X + ClusterCoordinates.X;
+	}
+
+	/** Returns the inclusive cell range of a cluster (clusters on the far faces may be smaller). */
+	void GetClusterCellRange(const FIntVector& ClusterCoordinates, FIntVector& OutMin, FIntVector& OutMax) const;
+
+	/** Recomputes the transitions between a cluster and its neighbour in one stored direction. */
+	void BuildTransitions(const FNavGrid& Grid, const FIntVector& ClusterCoordinates, int32 DirectionIndex);
+
+	/** Recomputes the abstract nodes and intra-cluster distances of a cluster. */
+	void BuildCluster(const FNavGrid& Grid, const FIntVector& ClusterCoordinates, FNavSearchContext& Context);
+
+	/** Rebuilds the flat abstract graph (node ids, links) from the per-cluster data. */
+	void BuildLinks(const FNavGrid& Grid);
+
+	/** Returns the abstract node of a transition cell, or INDEX_NONE. */
+	int32 FindNode(const FNavGrid& Grid, int32 Cell) const;
+
+	/**
+	 * Runs Dijkstra from a cell restricted to its cluster. Distances are left in Context
+	 * (Context.GetGScore), so they are only valid until the next search on that context.
+	 */
+	void SearchCluster(const FNavGrid& Grid, FNavSearchContext& Context, int32 SourceCell) const;
+
+	/** Cluster side length in cells. */
+	int32 ClusterSize = 8;
+
+	/** Clearance every abstracted cell must have. */
+	int32 RequiredClearance = 1;
+
+	/** Grid size in cells at build time. */
+	FIntVector GridSize = FIntVector::ZeroValue;
+
+	/** Number of clusters along each axis. */
+	FIntVector NumClusters = FIntVector::ZeroValue;
+
+	/** Stored neighbour directions (the 13 offsets whose first non-zero axis, from Z down to X, is positive). */
+	TArray<FIntVector> PairDirections;
+
+	/** Per-cluster data, by cluster index. */
+	TArray<FCluster> Clusters;
+
+	/** Transitions at [ClusterIndex * NumPairDirections + DirectionIndex], towards the cluster in that direction. */
+	TArray<TArray<FNavClusterTransition>> PairTransitions;
+
+	/** Abstract node ids of Clusters[C].Cells start at ClusterFirstNode[C]. Has one entry per cluster plus one. */
+	TArray<int32> ClusterFirstNode;
+
+	/** Cell of every abstract node. */
+	TArray<int32> NodeCells;
+
+	/** Links of node N are Links[FirstLink[N] .. FirstLink[N + 1]). */
+	TArray<int32> FirstLink;
+	TArray<FLink> Links;
+
+	/** Query scratch: abstract search state, start / goal links and the refined path. */
+	FNavSearchContext AbstractContext;
+	TArray<FLink> StartLinks;
+	TArray<float> GoalDistances;
+	TArray<int32> RefinedPath;
+};
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FNavGrid;
+
+/**
+ * FNavComponentLabels
+ *
+ * Connected components of the free space of a grid for one agent size class.
+ * - Built with union-find over the passable cells and grid links (the same links A* follows),
+ *   then flattened to one label per cell, so a reachability test is two array reads.
+ * - Only static geometry is considered. Dynamic obstacles can only cut paths further, so different
+ *   labels prove a goal unreachable while equal labels do not guarantee a path.
+ * - Labels are rebuilt as a whole whenever the grid changes: a change can both merge and split components.
+ * - Serialized run-length encoded (labels are constant along long runs of cells), so baking them is cheap.
+ */
+class SIMPLENAV3D_API FNavComponentLabels
+{
+public:
+	/** Inline capacity for the components a start cell touches (one, or up to its neighbour count if it is blocked). */
+	using FComponentList = TArray<int32, TInlineAllocator<8>>;
+
+	/**
+	 * Labels the cells of a grid that pass the clearance test.
+	 *
+	 * @param Grid                 Grid to label.
+	 * @param InRequiredClearance  Clearance a cell must have to be part of a component.
+	 */
+	void Build(const FNavGrid& Grid, int32 InRequiredClearance);
+
+	/** Releases the labels. */
+	void Reset();
+
+	/** Saves or loads the labels. Invalid data leaves them reset and sets the archive error. */
+	void Serialize(FArchive& Ar);
+
+	/** Returns true once Build has been called. */
+	FORCEINLINE bool IsBuilt() const { return Labels.Num() > 0; }
+
+	/** Returns the clearance the labels were built for. */
+	FORCEINLINE int32 GetRequiredClearance() const { return RequiredClearance; }
+
+	/** Returns the number of cells labelled. */
+	FORCEINLINE int32 GetNumCells() const { return Labels.Num(); }
+
+	/** Returns the number of components. */
+	FORCEINLINE int32 GetNumComponents() const { return NumComponents; }
+
+	/** Returns the component of a cell, or INDEX_NONE if the agent does not fit there. */
+	FORCEINLINE int32 GetLabel(int32 Cell) const { return Labels[Cell]; }
+
+	/**
+	 * Collects the components a search starting at a cell can enter: the cell's own, or for a cell
+	 * the agent does not fit in (a start touching geometry) those of its passable neighbours.
+	 */
+	void GetComponentsFrom(const FNavGrid& Grid, int32 Cell, FComponentList& OutComponents) const;
+
+	/** Returns true if a search from FromCell can reach ToCell on the static grid. */
+	bool AreConnected(const FNavGrid& Grid, int32 FromCell, int32 ToCell) const;
+
+private:
+	/** Component per cell (INDEX_NONE for cells failing the clearance test). Holds union-find parents during Build. */
+	TArray<int32> Labels;
+
+	int32 NumComponents = 0;
+	int32 RequiredClearance = 0;
+};
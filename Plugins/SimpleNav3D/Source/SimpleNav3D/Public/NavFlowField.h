@@ -0,0 +1,92 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavSearchContext.h"
+
+struct FNavGrid;
+
+/**
+ * FNavFlowField
+ *
+ * Distance (integration) field toward one goal cell, for many agents sharing that goal.
+ * - A reverse Dijkstra from the goal over the grid (clearance respected) gives every reached cell its path
+ *   cost to the goal and the neighbour to step to, so an agent samples its next cell in O(1) instead of
+ *   running its own A*.
+ * - The search can be bounded to a maximum path cost, and can run in slices (Step with an expansion
+ *   budget) so a large field is spread over several frames.
+ * - Per-cell state lives in an FNavSearchContext: generation-stamped, so restarting costs nothing
+ *   and storage is reused across goals.
+ * - Costs and steps are final only for settled cells; IsComplete tells when the whole field is.
+ */
+class SIMPLENAV3D_API FNavFlowField
+{
+public:
+	/**
+	 * Starts a field toward a goal cell. Previous results are discarded.
+	 *
+	 * @param Grid                Grid to search (the same grid must be passed to Step).
+	 * @param InGoalCell          Goal cell; the field is empty if the agent does not fit there.
+	 * @param InRequiredClearance Clearance every cell of the field must have.
+	 * @param InMaxCost           Cells farther than this path cost (in cells) are not reached; 0 for no bound.
+	 */
+	void Begin(const FNavGrid& Grid, int32 InGoalCell, int32 InRequiredClearance, float InMaxCost);
+
+	/**
+	 * Settles up to MaxExpansions cells.
+	 *
+	 * @param MaxExpansions  Expansion budget; 0 or less runs to completion.
+	 * @return true once the field is complete.
+	 */
+	bool Step(const FNavGrid& Grid, int32 MaxExpansions);
+
+	/** Drops the field and releases its storage. */
+	void Reset();
+
+	/** Returns true if Begin was called since the last Reset. */
+	FORCEINLINE bool IsStarted() const { return GoalCell != INDEX_NONE; }
+
+	/** Returns true once every reachable cell (within the cost bound) is settled. */
+	FORCEINLINE bool IsComplete() const { return IsStarted() && Context.OpenSet.IsEmpty(); }
+
+	/** Returns the goal cell, or INDEX_NONE. */
+	FORCEINLINE int32 GetGoalCell() const { return GoalCell; }
+
+	/** Returns the clearance the field was built for. */
+	FORCEINLINE int32 GetRequiredClearance() const { return RequiredClearance; }
+
+	/** Returns the cost bound the field was built with (0 for none). */
+	FORCEINLINE float GetMaxCost() const { return MaxCost; }
+
+	/** Returns the number of settled cells. */
+	FORCEINLINE int32 GetNumSettledCells() const { return Context.NumExpanded; }
+
+	/** Returns true if the cell has its final cost and step. */
+	FORCEINLINE bool IsSettled(int32 Cell) const { return IsStarted() && Context.IsClosed(Cell); }
+
+	/** Returns the path cost from a settled cell to the goal, or MAX_flt. */
+	FORCEINLINE float GetCost(int32 Cell) const
+	{
+		return IsSettled(Cell) ? Context.GetGScore(Cell) : MAX_flt;
+	}
+
+	/** Returns the neighbour a settled cell steps to, INDEX_NONE for the goal itself or cells not settled. */
+	FORCEINLINE int32 GetNextCell(int32 Cell) const
+	{
+		return IsSettled(Cell) ? Context.GetParent(Cell) : INDEX_NONE;
+	}
+
+	/**
+	 * Returns the settled neighbour of a cell closest to the goal, for agents standing in a cell the
+	 * field did not reach (pushed into geometry, or too narrow for the field's clearance). INDEX_NONE if none.
+	 */
+	int32 FindBestNeighbour(const FNavGrid& Grid, int32 Cell) const;
+
+private:
+	/** Costs (g-scores), steps (parents) and the open set. */
+	FNavSearchContext Context;
+
+	/** Field parameters. */
+	int32 GoalCell = INDEX_NONE;
+	int32 RequiredClearance = 0;
+	float MaxCost = 0.0f;
+};
@@ -0,0 +1,381 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * A single implicit neighbour link of the navigation grid.
+ * Stores the grid offset, the equivalent linear index delta and the traversal cost (in cells).
+ */
+struct FNavGridNeighbour
+{
+	/** Offset from the source cell in grid coordinates. */
+	FIntVector Offset = FIntVector::ZeroValue;
+
+	/** Offset from the source cell in linear index space. */
+	int32 IndexDelta = 0;
+
+	/** Euclidean length of the offset (1, sqrt(2) or sqrt(3)). */
+	float Cost = 0.0f;
+};
+
+/**
+ * FNavGrid
+ *
+ * Compact structure-of-arrays storage for the 3D navigation grid.
+ * - Cells are addressed by a linear index (X fastest, then Y, then Z); coordinates are derived from it.
+ * - Walkability is a bit-packed field (1 bit per cell, set = blocked).
+ * - An optional clearance layer stores, per cell, the Chebyshev distance (in cells) to the
+ *   nearest blocked cell, so "does an agent of radius R fit here" is a single comparison.
+ * - Optional brick storage for large, mostly empty volumes: cells are grouped in 8x8x8 bricks;
+ *   a brick whose cells all share a value (all free, all blocked, same clearance) is stored as
+ *   that value in a per-brick table, and only mixed bricks keep per-cell bits and clearance.
+ *   Searches over such a grid page their per-cell state the same way (GetSearchPagedSize).
+ *   Cell indices and the accessor API are the same in both modes.
+ * - Neighbours are implicit: generated on demand from a fixed offset table
+ *   filtered by the MinSharedNeighborAxes rule, so no per-cell adjacency is stored.
+ * - Grid <-> world conversion is a precomputed origin + cell-size affine transform
+ *   (the volume is axis-aligned; actor rotation and scale are ignored).
+ */
+struct SIMPLENAV3D_API FNavGrid
+{
+public:
+	/**
+	 * Allocates the grid and builds the neighbour offset table.
+	 *
+	 * @param InSizeX                  Number of cells along X.
+	 * @param InSizeY                  Number of cells along Y.
+	 * @param InSizeZ                  Number of cells along Z.
+	 * @param InMinSharedNeighborAxes  Minimum number of axes a neighbour must share (0 = 26-, 1 = 18-, 2 = 6-connected).
+	 * @param InOrigin                 World-space position of the grid's minimum corner.
+	 * @param InCellSize               Side length of one cell in world units.
+	 * @param bInBrickStorage          Store blocked bits and clearance per 8x8x8 brick (see class comment).
+	 */
+	void Init(int32 InSizeX, int32 InSizeY, int32 InSizeZ, int32 InMinSharedNeighborAxes, const FVector& InOrigin, float InCellSize, bool bInBrickStorage = false);
+
+	/** Releases all storage. */
+	void Reset();
+
+	/**
+	 * Saves or loads the grid (size, transform, blocked bits and clearance layer).
+	 * Bit and clearance arrays are bulk-serialized; the neighbour table is rebuilt on load.
+	 * A load whose array sizes do not match the grid size flags the archive as failed and resets the grid.
+	 */
+	void Serialize(FArchive& Ar);
+
+	/** Returns true once Init has been called with a non-empty size. */
+	FORCEINLINE bool IsInitialized() const { return NumCells > 0; }
+
+	/** Returns true if blocked bits and clearance are stored per brick. */
+	FORCEINLINE bool UsesBrickStorage() const { return bBrickStorage; }
+
+	/**
+	 * Returns the size searches over this grid page their per-cell state by (see TNavNodeArray): the grid
+	 * size with brick storage, so state follows the cells a search touches; zero (flat state) otherwise.
+	 */
+	FORCEINLINE FIntVector GetSearchPagedSize() const { return bBrickStorage ? GetSize() : FIntVector::ZeroValue; }
+
+	/** Returns the heap memory used by cell storage (bits, clearance, brick tables) in bytes. */
+	SIZE_T GetAllocatedSize() const;
+
+	/** Returns the total number of cells. */
+	FORCEINLINE int32 GetNumCells() const { return NumCells; }
+
+	/** Returns the grid size in cells along each axis. */
+	FORCEINLINE FIntVector GetSize() const { return FIntVector(SizeX, SizeY, SizeZ); }
+
+	/** Returns true if the specified grid coordinates are within the grid. */
+	FORCEINLINE bool IsValidCoordinates(const FIntVector& Coordinates) const
+	{
+		return Coordinates.X >= 0 && Coordinates.X < SizeX
+			&& Coordinates.Y >= 0 && Coordinates.Y < SizeY
+			&& Coordinates.Z >= 0 && Coordinates.Z < SizeZ;
+	}
+
+	/** Converts valid grid coordinates to a linear cell index. */
+	FORCEINLINE int32 GetIndex(const FIntVector& Coordinates) const
+	{
+		return (Coordinates.Z * SizeX * SizeY) + (Coordinates.Y * SizeX) + Coordinates.X;
+	}
+
+	/** Converts a linear cell index back to grid coordinates. */
+	FORCEINLINE FIntVector GetCoordinates(int32 Index) const
+	{
+		const int32 CellsPerLevel = SizeX * SizeY;
+		const int32 Z = Index / CellsPerLevel;
+		const int32 Remainder = Index - Z * CellsPerLevel;
+		const int32 Y = Remainder / SizeX;
+		return FIntVector(Remainder - Y * SizeX, Y, Z);
+	}
+
+	/** Returns the world-space position of the grid's minimum corner. */
+	FORCEINLINE const FVector& GetOrigin() const { return Origin; }
+
+	/** Returns the side length of one cell in world units. */
+	FORCEINLINE float GetCellSize() const { return CellSize; }
+
+	/** Returns the world-space center of the cell at the given grid coordinates. */
+	FORCEINLINE FVector GetCellCenter(const FIntVector& Coordinates) const
+	{
+		return CellCenterOrigin + FVector(Coordinates) * CellSize;
+	}
+
+	/** Returns the world-space center of the cell at the given linear index. */
+	FORCEINLINE FVector GetCellCenter(int32 Index) const
+	{
+		return GetCellCenter(GetCoordinates(Index));
+	}
+
+	/** Converts a world-space location to grid coordinates, clamped to the grid. */
+	FORCEINLINE FIntVector GetClampedCoordinates(const FVector& WorldLocation) const
+	{
+		const FVector GridSpacePos = (WorldLocation - Origin) * InvCellSize;
+		return FIntVector(
+			FMath::Clamp(FMath::FloorToInt(GridSpacePos.X), 0, SizeX - 1),
+			FMath::Clamp(FMath::FloorToInt(GridSpacePos.Y), 0, SizeY - 1),
+			FMath::Clamp(FMath::FloorToInt(GridSpacePos.Z), 0, SizeZ - 1));
+	}
+
+	/**
+	 * Computes the inclusive range of cells whose centers lie inside a world-space box.
+	 * The box is treated as half-open (Min <= center < Max), matching the octree's ">= center" split rule.
+	 *
+	 * @return false if no cell center lies inside the box.
+	 */
+	bool GetCellRangeInBox(const FBox& Box, FIntVector& OutMin, FIntVector& OutMax) const;
+
+	/** Marks every cell in the inclusive coordinate range as blocked or free. */
+	void SetBlockedRange(const FIntVector& Min, const FIntVector& Max, bool bBlocked);
+
+	/** Returns true if the cell is marked as blocked. */
+	FORCEINLINE bool IsBlocked(int32 Index) const
+	{
+		if (!bBrickStorage)
+		{
+			return (BlockedBits[Index >> 6] >> (Index & 63)) & 1;
+		}
+
+		int32 Local;
+		const int32 Offset = BrickBitOffsets[GetBrick(Index, Local)];
+		return Offset < 0
+			? Offset == UniformBlockedBrick
+			: (BrickBits[Offset + (Local >> 6)] >> (Local & 63)) & 1;
+	}
+
+	/** Marks a cell as blocked or free. */
+	FORCEINLINE void SetBlocked(int32 Index, bool bBlocked)
+	{
+		if (bBrickStorage)
+		{
+			SetBlockedInBrick(Index, bBlocked);
+			return;
+		}
+
+		const uint64 Mask = uint64(1) << (Index & 63);
+		if (bBlocked)
+		{
+			BlockedBits[Index >> 6] |= Mask;
+		}
+		else
+		{
+			BlockedBits[Index >> 6] &= ~Mask;
+		}
+	}
+
+	// --------------------------------------------------------------------
+	// Clearance
+	// --------------------------------------------------------------------
+
+	/**
+	 * Computes the clearance layer for the whole grid from the blocked bits.
+	 *
+	 * @param InMaxClearance  Clearance values are capped at this many cells (1..255).
+	 */
+	void BuildClearance(int32 InMaxClearance);
+
+	/**
+	 * Recomputes clearance after the blocked bits changed inside an inclusive cell range.
+	 * Only cells within MaxClearance of the range can change, so only those are rewritten.
+	 */
+	void UpdateClearance(const FIntVector& DirtyMin, const FIntVector& DirtyMax);
+
+	/** Returns true once BuildClearance has been called. */
+	FORCEINLINE bool HasClearanceLayer() const
+	{
+		return NumCells > 0 && (bBrickStorage ? BrickClearanceOffsets.Num() > 0 : Clearance.Num() == NumCells);
+	}
+
+	/** Returns the cap applied to clearance values (a blocked-bit change affects clearance this many cells away). */
+	FORCEINLINE int32 GetMaxClearance() const { return MaxClearance; }
+
+	/** Returns the capped Chebyshev distance (in cells) from a cell to the nearest blocked cell (0 = blocked). */
+	FORCEINLINE uint8 GetClearance(int32 Index) const
+	{
+		if (!bBrickStorage)
+		{
+			return Clearance[Index];
+		}
+
+		int32 Local;
+		const int32 Offset = BrickClearanceOffsets[GetBrick(Index, Local)];
+		return Offset < 0 ? static_cast<uint8>(-1 - Offset) : BrickClearance[Offset + Local];
+	}
+
+	/** Returns true if the cell is free and at least RequiredClearance cells away from any blocked cell. */
+	FORCEINLINE bool HasClearance(int32 Index, int32 RequiredClearance) const
+	{
+		return GetClearance(Index) >= RequiredClearance;
+	}
+
+	/**
+	 * Returns true if an agent needing RequiredClearance can occupy the cell.
+	 * Falls back to the blocked bit when no clearance layer has been built.
+	 */
+	FORCEINLINE bool IsPassable(int32 Index, int32 RequiredClearance) const
+	{
+		return HasClearanceLayer() ? HasClearance(Index, RequiredClearance) : !IsBlocked(Index);
+	}
+
+	/**
+	 * Converts an agent capsule to the clearance (in cells) its center cell needs.
+	 * A blocked cell at Chebyshev distance d is at least (d - 0.5) * CellSize away from the cell center
+	 * along some axis, so the capsule fits when that distance covers its radius and half-height.
+	 * Always at least 1 (the cell itself must be free) and at most MaxClearance.
+	 */
+	int32 GetRequiredClearance(float AgentRadius, float AgentHalfHeight) const;
+
+	/** Returns the connectivity rule the neighbour offsets were built with. */
+	FORCEINLINE int32 GetMinSharedNeighborAxes() const { return MinSharedNeighborAxes; }
+
+	/** Returns the neighbour offsets allowed by the connectivity rule. */
+	FORCEINLINE const TArray<FNavGridNeighbour>& GetNeighbourOffsets() const { return Neighbours; }
+
+	/**
+	 * Invokes Func(NeighbourIndex, Cost) for every in-bounds neighbour of a cell.
+	 * Interior cells skip the per-offset bounds test.
+	 */
+	template <typename FuncType>
+	FORCEINLINE void ForEachNeighbour(int32 Index, FuncType&& Func) const
+	{
+		const FIntVector Coordinates = GetCoordinates(Index);
+
+		const bool bInterior =
+			Coordinates.X > 0 && Coordinates.X < SizeX - 1 &&
+			Coordinates.Y > 0 && Coordinates.Y < SizeY - 1 &&
+			Coordinates.Z > 0 && Coordinates.Z < SizeZ - 1;
+
+		for (const FNavGridNeighbour& Neighbour : Neighbours)
+		{
+			if (bInterior || IsValidCoordinates(Coordinates + Neighbour.Offset))
+			{
+				Func(Index + Neighbour.IndexDelta, Neighbour.Cost);
+			}
+		}
+	}
+
+private:
+	/** Grid size in cells. */
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	int32 SizeZ = 0;
+
+	/** Cached SizeX * SizeY * SizeZ. */
+	int32 NumCells = 0;
+
+	/** Affine grid -> world mapping. */
+	FVector Origin = FVector::ZeroVector;
+	FVector CellCenterOrigin = FVector::ZeroVector;
+	float CellSize = 1.0f;
+	float InvCellSize = 1.0f;
+
+	/** Bit-packed blocked flags, 64 cells per word (dense storage only). */
+	TArray<uint64> BlockedBits;
+
+	/** Per-cell capped Chebyshev distance to the nearest blocked cell (dense storage only; empty until BuildClearance). */
+	TArray<uint8> Clearance;
+
+	/** Cap applied to clearance values. */
+	int32 MaxClearance = 1;
+
+	/**
+	 * Computes clearance for the inclusive cell range [Min, Max] from the current blocked bits.
+	 *
+	 * @param OutValues  Receives one value per cell of the range, X fastest, then Y, then Z.
+	 */
+	void ComputeClearanceRegion(const FIntVector& Min, const FIntVector& Max, TArray<uint8>& OutValues) const;
+
+	// --------------------------------------------------------------------
+	// Brick storage
+	// --------------------------------------------------------------------
+
+	/** Bricks are BrickSize cells along each axis. */
+	static constexpr int32 BrickShift = 3;
+	static constexpr int32 BrickSize = 1 << BrickShift;
+	static constexpr int32 BrickMask = BrickSize - 1;
+	static constexpr int32 CellsPerBrick = BrickSize * BrickSize * BrickSize;
+	static constexpr int32 WordsPerBrick = CellsPerBrick / 64;
+
+	/** BrickBitOffsets values of uniform bricks; mixed bricks store their first word in BrickBits. */
+	static constexpr int32 UniformFreeBrick = -1;
+	static constexpr int32 UniformBlockedBrick = -2;
+
+	/** Returns the brick containing a cell, and the cell's index inside the brick (X fastest). */
+	FORCEINLINE int32 GetBrick(int32 Index, int32& OutLocal) const
+	{
+		const FIntVector Cell = GetCoordinates(Index);
+		OutLocal = ((Cell.Z & BrickMask) << (2 * BrickShift)) | ((Cell.Y & BrickMask) << BrickShift) | (Cell.X & BrickMask);
+		return ((Cell.Z >> BrickShift) * NumBricksY + (Cell.Y >> BrickShift)) * NumBricksX + (Cell.X >> BrickShift);
+	}
+
+	/** Returns the inclusive cell range of a brick, clamped to the grid. */
+	void GetBrickCellRange(int32 BrickX, int32 BrickY, int32 BrickZ, FIntVector& OutMin, FIntVector& OutMax) const;
+
+	/** SetBlocked for brick storage. Expands a uniform brick to bits if the value differs; never collapses. */
+	void SetBlockedInBrick(int32 Index, bool bBlocked);
+
+	/** Returns the first word of a brick's bits, expanding a uniform brick to bits (filled with its value) first. */
+	int32 ExpandBitBrick(int32 Brick);
+
+	/** Returns a mixed brick's bits to the free list if its cells (inside the grid) now share a value. */
+	void CollapseBitBrick(int32 Brick, const FIntVector& CellMin, const FIntVector& CellMax);
+
+	/** Rewrites clearance for the inclusive cell range (whole bricks in brick storage). */
+	void RecomputeClearance(const FIntVector& Min, const FIntVector& Max);
+
+	/** Recomputes clearance of every brick overlapping the inclusive cell range. */
+	void UpdateClearanceBricks(const FIntVector& Min, const FIntVector& Max);
+
+	/** Number of bricks along each axis. */
+	int32 NumBricksX = 0;
+	int32 NumBricksY = 0;
+	int32 NumBricksZ = 0;
+
+	/** Whether blocked bits and clearance are stored per brick. */
+	bool bBrickStorage = false;
+
+	/** Per brick: UniformFreeBrick, UniformBlockedBrick, or the first of its WordsPerBrick words in BrickBits. */
+	TArray<int32> BrickBitOffsets;
+
+	/** Bits of mixed bricks, WordsPerBrick words each. */
+	TArray<uint64> BrickBits;
+
+	/** Released BrickBits blocks, by first word. */
+	TArray<int32> FreeBitBlocks;
+
+	/** Per brick: -1 - Value for a uniform clearance Value, or the first of its CellsPerBrick bytes in BrickClearance. */
+	TArray<int32> BrickClearanceOffsets;
+
+	/** Clearance of mixed bricks, CellsPerBrick bytes each. */
+	TArray<uint8> BrickClearance;
+
+	/** Released BrickClearance blocks, by first byte. */
+	TArray<int32> FreeClearanceBlocks;
+
+	/** Fills Neighbours from the offset table and MinSharedNeighborAxes. */
+	void BuildNeighbourOffsets();
+
+	/** Minimum number of axes a neighbour must share with its source cell. */
+	int32 MinSharedNeighborAxes = 0;
+
+	/** Neighbour offsets that pass the MinSharedNeighborAxes rule. */
+	TArray<FNavGridNeighbour> Neighbours;
+};
@@ -0,0 +1,185 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavNodeArray.h"
+
+struct FNavGrid;
+struct FNavOccupancyLayer;
+
+/**
+ * FNavIncrementalPlanner
+ *
+ * Persistent planner for one agent that replans toward a moving goal (D* Lite).
+ * - The search runs backward from the goal and keeps its tree between calls: every touched cell
+ *   keeps its cost to the goal (g) and a one-step lookahead of it (rhs), and only cells where the
+ *   two disagree are queued.
+ * - The agent moving along its path costs nothing: keys are offset by the heuristic distance it
+ *   moved (km) instead of being recomputed, so the queue stays valid.
+ * - Cells reported by NotifyCellsChanged (geometry or dynamic obstacles) are re-evaluated on the next
+ *   Plan; the repair only propagates as far as costs actually changed.
+ * - A goal that moves a short distance is repaired like a changed cell (the old goal loses its zero
+ *   cost, the new one gains it). A goal that jumps far restarts the search, which is cheaper than
+ *   repairing most of the tree.
+ * - Per-cell state is generation-stamped like FNavSearchContext, so a restart costs nothing and
+ *   storage is reused; on brick-storage grids it is paged by brick, so it follows the cells searched.
+ *
+ * Cells the agent does not fit in (clearance) or where it would overlap a dynamic obstacle other than
+ * its own (the obstacle widened by the same clearance) cannot be entered; the agent's own cell is exempt.
+ */
+class SIMPLENAV3D_API FNavIncrementalPlanner
+{
+public:
+	/** Changed ranges queued beyond this many restart the search on the next Plan instead of being repaired. */
+	static constexpr int32 MaxChangedRanges = 256;
+
+	/**
+	 * Relative slack on the start's key when deciding the search is done. Cells on a shortest path tie
+	 * with the start's key in exact arithmetic; float rounding must not leave them unexpanded.
+	 */
+	static constexpr float KeyTolerance = 1.0e-4f;
+
+	/**
+	 * Sets the agent the planner searches for. Drops the search tree.
+	 *
+	 * @param InRequiredClearance Clearance every cell of the path must have.
+	 */
+	void Init(int32 InRequiredClearance);
+
+	/** Drops the search tree and releases its storage. */
+	void Reset();
+
+	/**
+	 * Queues an inclusive cell range whose passability changed. Cells next to the range are
+	 * re-evaluated as well, since their cost depends on it.
+	 */
+	void NotifyCellsChanged(const FIntVector& MinCell, const FIntVector& MaxCell);
+
+	/**
+	 * Repairs the search tree for the current start, goal and queued changes, then extracts the path.
+	 *
+	 * @param InGrid                Grid to search; a grid of another size restarts the search.
+	 * @param InOccupancy           Current dynamic obstacles (may be null).
+	 * @param InStartCell           Cell the agent is in.
+	 * @param InGoalCell            Cell to reach.
+	 * @param InIgnoredObstacleSlot Dynamic obstacle slot of the agent itself, or INDEX_NONE; a new slot restarts the search.
+	 *
+	 * @return true if a path was found; it is in GetPathNodes (start first).
+	 */
+	bool Plan(const FNavGrid& InGrid, const FNavOccupancyLayer* InOccupancy, int32 InStartCell, int32 InGoalCell, int32 InIgnoredObstacleSlot = INDEX_NONE);
+
+	/** Returns the clearance the planner searches for. */
+	FORCEINLINE int32 GetRequiredClearance() const { return RequiredClearance; }
+
+	/** Returns the cells of the last path found, start first. */
+	FORCEINLINE const TArray<int32>& GetPathNodes() const { return PathNodes; }
+
+	/** Returns the number of cells expanded by the last Plan (for profiling). */
+	FORCEINLINE int32 GetNumExpandedLastPlan() const { return NumExpandedLastPlan; }
+
+	/** Returns true if the last Plan started a new search instead of repairing the previous one. */
+	FORCEINLINE bool WasLastPlanRestarted() const { return bLastPlanRestarted; }
+
+private:
+	/** Per-cell search state. Only meaningful when Generation matches the planner's generation. */
+	struct FNode
+	{
+		/** Cost to the goal as of the last expansion. */
+		float G = MAX_flt;
+
+		/** Cost to the goal through the best neighbour (0 for the goal). */
+		float RHS = MAX_flt;
+
+		/** Key the cell was last queued with. */
+		float Key1 = 0.0f;
+		float Key2 = 0.0f;
+
+		uint32 Generation = 0;
+
+		/** Whether the cell is queued (G and RHS disagree). */
+		bool bOpen = false;
+	};
+
+	/** Queue entry. Entries whose key no longer matches the cell's queued key are stale and skipped. */
+	struct FOpenEntry
+	{
+		float Key1;
+		float Key2;
+		int32 Cell;
+	};
+
+	/** Orders queue entries by key, lexicographically. */
+	struct FOpenEntryLess
+	{
+		FORCEINLINE bool operator()(const FOpenEntry& A, const FOpenEntry& B) const
+		{
+			return A.Key1 < B.Key1 || (A.Key1 == B.Key1 && A.Key2 < B.Key2);
+		}
+	};
+
+	/** Starts a new search tree rooted at GoalCell. */
+	void BeginSearch(int32 NumCells, const FIntVector& PagedSize, int32 InGoalCell);
+
+	/** Returns the state of a cell, resetting it on first access in the current search. */
+	FNode& Touch(int32 Cell);
+
+	/** Returns the cost to the goal of a cell as of its last expansion ("infinite" if not reached). */
+	FORCEINLINE float GetG(int32 Cell) const
+	{
+		const FNode& Node = Nodes[Cell];
+		return (Node.Generation == Generation) ? Node.G : MAX_flt;
+	}
+
+	/** Returns true if the agent may enter the cell. */
+	bool IsFree(int32 Cell) const;
+
+	/** Heuristic distance from the current start to a cell. */
+	float GetHeuristic(int32 Cell) const;
+
+	/** Recomputes the rhs of a cell from its neighbours and (de)queues it accordingly. */
+	void UpdateCell(int32 Cell);
+
+	/** Queues a cell with its current key, or dequeues it if it is consistent. */
+	void UpdateQueue(int32 Cell, FNode& Node);
+
+	/** Drops stale entries from the top of the queue. */
+	void PruneQueueTop();
+
+	/** Expands queued cells until the start is consistent and nothing cheaper is queued. */
+	void ComputeShortestPath();
+
+	/** Walks from the start to the goal along the cheapest neighbours into PathNodes. */
+	bool ExtractPath();
+
+	/** Per-cell state, indexed by linear cell index. */
+	TNavNodeArray<FNode> Nodes;
+
+	/** Binary heap of queue entries, with stale entries left in place until they surface. */
+	TArray<FOpenEntry> Open;
+	int32 NumOpenCells = 0;
+
+	/** Inclusive cell ranges changed since the last Plan. */
+	TArray<TPair<FIntVector, FIntVector>> ChangedRanges;
+
+	/** Cells of the last path found, start first. */
+	TArray<int32> PathNodes;
+
+	/** Inputs of the current Plan call (valid during Plan only). */
+	const FNavGrid* Grid = nullptr;
+	const FNavOccupancyLayer* Occupancy = nullptr;
+
+	/** Agent parameters. */
+	int32 RequiredClearance = 1;
+	int32 IgnoredObstacleSlot = INDEX_NONE;
+
+	/** Search tree root and the start the keys are relative to. */
+	int32 GoalCell = INDEX_NONE;
+	int32 StartCell = INDEX_NONE;
+	FVector StartCoordinates = FVector::ZeroVector;
+
+	/** Accumulated heuristic distance the start moved since the search began. */
+	float KeyModifier = 0.0f;
+
+	uint32 Generation = 0;
+	int32 NumExpandedLastPlan = 0;
+	bool bLastPlanRestarted = false;
+};
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * TNavNodeArray
+ *
+ * Per-node search state indexed by node index, as used by the search contexts.
+ * - Flat (the default): one element per node in a plain array, grown on demand.
+ * - Paged, for grids too large to hold state for every cell (brick storage): one page per block of
+ *   PageSize^3 cells, allocated the first time a query writes one of its cells. Memory then follows
+ *   the cells a query touches instead of the grid's bounding box.
+ * - Cells without a page read as a default-constructed element; owners stamp elements with a query
+ *   generation, so the default (generation 0) always reads as untouched.
+ * - Pages are recycled by the next query instead of freed, so a warm array does not allocate.
+ *
+ * References returned by the mutable accessor stay valid while other pages are allocated.
+ */
+template <typename ElementType>
+class TNavNodeArray
+{
+public:
+	/** Pages are PageSize cells along each axis (the size of a grid brick). */
+	static constexpr int32 PageShift = 3;
+	static constexpr int32 PageSize = 1 << PageShift;
+	static constexpr int32 PageMask = PageSize - 1;
+	static constexpr int32 CellsPerPage = PageSize * PageSize * PageSize;
+
+	/**
+	 * Prepares the array for a new query over InNumNodes nodes. Elements of a previous query keep
+	 * their stamps (flat) or their pages are recycled (paged).
+	 *
+	 * @param InNumNodes   Number of nodes (cells) the query may touch.
+	 * @param InPagedSize  Grid size to page the cells by, or zero for flat storage (also for non-grid graphs).
+	 */
+	void Reset(int32 InNumNodes, const FIntVector& InPagedSize)
+	{
+		NumNodes = InNumNodes;
+		PagedSize = InPagedSize;
+		PageOfBlock.Reset();
+		NumUsedPages = 0;
+		CachedBlock = INDEX_NONE;
+
+		if (IsPaged())
+		{
+			Flat.Empty();
+			NumBlocksX = (PagedSize.X + PageMask) >> PageShift;
+			NumBlocksY = (PagedSize.Y + PageMask) >> PageShift;
+		}
+		else
+		{
+			Pages.Empty();
+			if (Flat.Num() < NumNodes)
+			{
+				Flat.SetNum(NumNodes);
+			}
+		}
+	}
+
+	/** Releases all storage. */
+	void Empty()
+	{
+		Flat.Empty();
+		Pages.Empty();
+		PageOfBlock.Empty();
+		NumUsedPages = 0;
+		NumNodes = 0;
+		PagedSize = FIntVector::ZeroValue;
+		CachedBlock = INDEX_NONE;
+	}
+
+	/** Returns true if Reset was last called with these parameters. */
+	FORCEINLINE bool IsLayoutFor(int32 InNumNodes, const FIntVector& InPagedSize) const
+	{
+		return NumNodes == InNumNodes && PagedSize == InPagedSize;
+	}
+
+	/** Returns true if cells are stored in pages. */
+	FORCEINLINE bool IsPaged() const { return PagedSize != FIntVector::ZeroValue; }
+
+	/** Returns the element of a node for reading; a default element if its page was never written. */
+	FORCEINLINE const ElementType& operator[](int32 Index) const
+	{
+		if (!IsPaged())
+		{
+			return Flat[Index];
+		}
+
+		int32 Local;
+		const int32 Block = GetBlock(Index, Local);
+		if (Block != CachedBlock)
+		{
+			const int32* Page = PageOfBlock.Find(Block);
+			if (!Page)
+			{
+				static const ElementType DefaultElement;
+				return DefaultElement;
+			}
+			CachedBlock = Block;
+			CachedPage = *Page;
+		}
+		return Pages[CachedPage].Elements[Local];
+	}
+
+	/** Returns the element of a node for writing, assigning its page on first use in the query. */
+	FORCEINLINE ElementType& operator[](int32 Index)
+	{
+		if (!IsPaged())
+		{
+			return Flat[Index];
+		}
+
+		int32 Local;
+		const int32 Block = GetBlock(Index, Local);
+		if (Block != CachedBlock)
+		{
+			int32& Page = PageOfBlock.FindOrAdd(Block, INDEX_NONE);
+			if (Page == INDEX_NONE)
+			{
+				Page = AssignPage();
+			}
+			CachedBlock = Block;
+			CachedPage = Page;
+		}
+		return Pages[CachedPage].Elements[Local];
+	}
+
+	/** Calls Func on every stored element, including those of pages not used by the current query. */
+	template <typename FuncType>
+	void ForEachElement(FuncType&& Func)
+	{
+		for (ElementType& Element : Flat)
+		{
+			Func(Element);
+		}
+		for (FPage& Page : Pages)
+		{
+			for (ElementType& Element : Page.Elements)
+			{
+				Func(Element);
+			}
+		}
+	}
+
+private:
+	/** Elements of one block of cells, X fastest. Allocated individually so elements never move. */
+	struct FPage
+	{
+		ElementType Elements[CellsPerPage];
+	};
+
+	/** Returns the block containing a cell, and the cell's index inside the block. */
+	FORCEINLINE int32 GetBlock(int32 Index, int32& OutLocal) const
+	{
+		const int32 X = Index % PagedSize.X;
+		const int32 YZ = Index / PagedSize.X;
+		const int32 Y = YZ % PagedSize.Y;
+		const int32 Z = YZ / PagedSize.Y;
+		OutLocal = ((Z & PageMask) << (2 * PageShift)) | ((Y & PageMask) << PageShift) | (X & PageMask);
+		return ((Z >> PageShift) * NumBlocksY + (Y >> PageShift)) * NumBlocksX + (X >> PageShift);
+	}
+
+	/**
+	 * Hands out the next page, allocating one if every page is in use. A recycled page still holds
+	 * elements stamped by an older query, which its owner treats as untouched.
+	 */
+	int32 AssignPage()
+	{
+		if (NumUsedPages == Pages.Num())
+		{
+			Pages.Add(new FPage());
+		}
+		return NumUsedPages++;
+	}
+
+	/** Flat storage, one element per node. */
+	TArray<ElementType> Flat;
+
+	/** Page pool; the first NumUsedPages are assigned to blocks in the current query. */
+	TIndirectArray<FPage> Pages;
+	int32 NumUsedPages = 0;
+
+	/** Page assigned to each block touched by the current query. */
+	TMap<int32, int32> PageOfBlock;
+
+	/** Layout passed to the last Reset. */
+	int32 NumNodes = 0;
+	FIntVector PagedSize = FIntVector::ZeroValue;
+	int32 NumBlocksX = 0;
+	int32 NumBlocksY = 0;
+
+	/** Last block looked up: neighbouring cells mostly share a block, which skips the map lookup. */
+	mutable int32 CachedBlock = INDEX_NONE;
+	mutable int32 CachedPage = INDEX_NONE;
+};
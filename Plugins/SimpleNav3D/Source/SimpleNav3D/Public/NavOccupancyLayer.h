@@ -0,0 +1,110 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * FNavOccupancyLayer
+ *
+ * Cells covered by dynamic obstacles (registered movers), kept next to the baked FNavGrid.
+ * - Each obstacle covers one inclusive cell range; the union is a bit-packed field (set = occupied),
+ *   so a search tests one bit per cell instead of running a physics query.
+ * - Obstacles only touch the bits when their range changes (they crossed a cell boundary):
+ *   Flush rewrites the old and new ranges and re-stamps every obstacle overlapping them.
+ * - Obstacle slots are stable ids (reused after removal), so a query can ignore the agent's own obstacle.
+ * - The bits are allocated when the first obstacle covers cells, so large volumes without obstacles pay nothing.
+ */
+struct SIMPLENAV3D_API FNavOccupancyLayer
+{
+public:
+	/** Sizes an all-free layer to match a grid. Removes all obstacles. */
+	void Init(const FIntVector& InSize);
+
+	/** Releases all storage. */
+	void Reset();
+
+	/** Returns true once Init has been called with a non-empty size. */
+	FORCEINLINE bool IsInitialized() const { return NumCells > 0; }
+
+	/** Returns a new obstacle slot covering no cells. */
+	int32 AddObstacle();
+
+	/** Frees an obstacle slot; its cells are released by the next Flush. */
+	void RemoveObstacle(int32 Slot);
+
+	/** Sets the inclusive cell range an obstacle covers. No-op if it did not change. */
+	void SetObstacleRange(int32 Slot, const FIntVector& Min, const FIntVector& Max);
+
+	/** Makes an obstacle cover no cells (e.g. it left the grid). */
+	void ClearObstacleRange(int32 Slot);
+
+	/** Returns true if obstacle changes are waiting for Flush. */
+	FORCEINLINE bool IsDirty() const { return DirtyRanges.Num() > 0; }
+
+	/**
+	 * Applies pending obstacle changes to the bits.
+	 *
+	 * @return true if any range was rewritten.
+	 */
+	bool Flush();
+
+	/** Returns true if at least one obstacle covered cells at the last Flush. */
+	FORCEINLINE bool HasOccupiedCells() const { return NumObstaclesWithCells > 0; }
+
+	/** Returns true if any obstacle covers the cell. */
+	FORCEINLINE bool IsOccupied(int32 Index) const
+	{
+		return Bits.Num() > 0 && ((Bits[Index >> 6] >> (Index & 63)) & 1);
+	}
+
+	/** Returns true if an obstacle other than IgnoredSlot covers the cell (IgnoredSlot may be INDEX_NONE). */
+	bool IsOccupied(int32 Index, int32 IgnoredSlot) const;
+
+	/** Returns true if an obstacle other than IgnoredSlot covers any cell of the inclusive range. */
+	bool IsRangeOccupied(const FIntVector& Min, const FIntVector& Max, int32 IgnoredSlot) const;
+
+	/**
+	 * Returns true if an obstacle other than IgnoredSlot covers a cell within RequiredClearance - 1 cells
+	 * (Chebyshev) of the cell, i.e. an agent of that clearance centered there would overlap it. This is
+	 * the clearance layer's test applied to obstacles; a clearance of 1 tests the cell alone.
+	 */
+	bool IsOccupiedAround(int32 Index, int32 RequiredClearance, int32 IgnoredSlot) const;
+
+private:
+	/** Cell range of one obstacle slot. */
+	struct FObstacle
+	{
+		FIntVector Min = FIntVector::ZeroValue;
+		FIntVector Max = FIntVector::ZeroValue;
+		bool bHasCells = false;
+		bool bInUse = false;
+	};
+
+	/** Returns the cell coordinates of a linear index. */
+	FORCEINLINE FIntVector GetCoordinates(int32 Index) const
+	{
+		const int32 CellsPerLevel = Size.X * Size.Y;
+		const int32 Z = Index / CellsPerLevel;
+		const int32 Remainder = Index - Z * CellsPerLevel;
+		return FIntVector(Remainder % Size.X, Remainder / Size.X, Z);
+	}
+
+	/** Sets or clears every bit of an inclusive range. */
+	void SetRangeBits(const FIntVector& Min, const FIntVector& Max, bool bOccupied);
+
+	/** Layer size in cells (matches the grid). */
+	FIntVector Size = FIntVector::ZeroValue;
+	int32 NumCells = 0;
+
+	/** Bit-packed occupancy, 64 cells per word (empty until an obstacle covers cells). */
+	TArray<uint64> Bits;
+
+	/** Obstacles by slot, and slots free for reuse. */
+	TArray<FObstacle> Obstacles;
+	TArray<int32> FreeSlots;
+
+	/** Old and new ranges of obstacles changed since the last Flush. */
+	TArray<TPair<FIntVector, FIntVector>> DirtyRanges;
+
+	/** Obstacles covering cells at the last Flush. */
+	int32 NumObstaclesWithCells = 0;
+};
@@ -0,0 +1,203 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Octree node stored in FNavOctree's node arena.
+ * Bounds are not stored: they are derived from the root bounds while descending.
+ */
+struct FNavOctreeNode
+{
+	/** Index of the first of 8 consecutive children, or INDEX_NONE for leaves. */
+	int32 FirstChild = INDEX_NONE;
+
+	/** Whether this leaf's region is considered blocked (e.g., overlaps geometry). Unused for inner nodes. */
+	bool bBlocked = false;
+
+	/** Whether this node is a leaf in the octree. */
+	FORCEINLINE bool IsLeaf() const { return FirstChild == INDEX_NONE; }
+
+	friend FArchive& operator<<(FArchive& Ar, FNavOctreeNode& Node)
+	{
+		Ar << Node.FirstChild;
+		uint8 bBlockedByte = Node.bBlocked;
+		Ar << bBlockedByte;
+		Node.bBlocked = bBlockedByte != 0;
+		return Ar;
+	}
+};
+
+/**
+ * A leaf produced by FNavOctree::Build, with its world-space bounds.
+ */
+struct FNavOctreeLeaf
+{
+	/** Index of the leaf in the node arena. */
+	int32 NodeIndex = INDEX_NONE;
+
+	/** World-space bounds of the leaf. */
+	FBox Bounds = FBox(ForceInit);
+};
+
+/**
+ * FNavOctree
+ *
+ * Pointerless octree used for coarse 3D occupancy / blockage queries.
+ * - All nodes live in one contiguous array; the 8 children of a node are stored consecutively,
+ *   so a node only needs the index of its first child. Destroying the tree frees one allocation.
+ * - Child octants are numbered by bit: bit 0 = high X, bit 1 = high Y, bit 2 = high Z.
+ *   A point on a split plane belongs to the high side.
+ * - After classification, subtrees whose leaves are all blocked (or all free) are merged into a single leaf.
+ */
+struct SIMPLENAV3D_API FNavOctree
+{
+public:
+	/**
+	 * Builds the node hierarchy for the given bounds, splitting until either
+	 * the minimum cell size or maximum depth is reached. All leaves start free.
+	 *
+	 * @param InRootBounds   World-space bounds of the root node.
+	 * @param InMinCellSize  A node whose largest side is at most this size becomes a leaf.
+	 * @param InMaxDepth     Nodes at this depth become leaves.
+	 * @param OutLeaves      Receives every leaf with its bounds, in depth-first order.
+	 */
+	void Build(const FBox& InRootBounds, float InMinCellSize, int32 InMaxDepth, TArray<FNavOctreeLeaf>& OutLeaves);
+
+	/**
+	 * Merges every subtree whose leaves share the same blocked flag into one leaf,
+	 * then compacts the arena (breadth-first, sibling groups kept contiguous).
+	 */
+	void CollapseUniformSubtrees();
+
+	/**
+	 * Prepares a region for re-classification after the scene changed inside it.
+	 * Leaves overlapping the region are split again down to the build criteria (children of a split
+	 * leaf inherit its blocked flag) and every leaf overlapping the region is reported, so only those
+	 * need a new blockage test. Call CollapseUniformSubtrees once the reported leaves are updated.
+	 *
+	 * @param Region     World-space box whose contents changed.
+	 * @param OutLeaves  Receives the leaves overlapping the region, with their bounds.
+	 */
+	void RefineRegion(const FBox& Region, TArray<FNavOctreeLeaf>& OutLeaves);
+
+	/** Releases all nodes. */
+	void Reset();
+
+	/**
+	 * Saves or loads the node arena, root bounds and split parameters (so RefineRegion works after a load).
+	 * A load whose child links are out of range flags the archive as failed and resets the tree.
+	 */
+	void Serialize(FArchive& Ar);
+
+	/** Returns true if the tree has no nodes. */
+	FORCEINLINE bool IsEmpty() const { return Nodes.Num() == 0; }
+
+	/** Returns the number of nodes in the arena. */
+	FORCEINLINE int32 GetNumNodes() const { return Nodes.Num(); }
+
+	/** Returns the world-space bounds of the root node. */
+	FORCEINLINE const FBox& GetRootBounds() const { return RootBounds; }
+
+	/** Returns a node by arena index. */
+	FORCEINLINE FNavOctreeNode& GetNode(int32 Index) { return Nodes[Index]; }
+	FORCEINLINE const FNavOctreeNode& GetNode(int32 Index) const { return Nodes[Index]; }
+
+	/** Returns the bounds of one of the 8 octants of a box. */
+	static FORCEINLINE FBox GetChildBounds(const FBox& ParentBounds, int32 ChildIndex)
+	{
+		const FVector Center = ParentBounds.GetCenter();
+		FBox Child = ParentBounds;
+		(ChildIndex & 1 ? Child.Min.X : Child.Max.X) = Center.X;
+		(ChildIndex & 2 ? Child.Min.Y : Child.Max.Y) = Center.Y;
+		(ChildIndex & 4 ? Child.Min.Z : Child.Max.Z) = Center.Z;
+		return Child;
+	}
+
+	/**
+	 * Returns the leaf containing the point, or INDEX_NONE outside the tree.
+	 *
+	 * @param WorldPoint   World-space position to locate.
+	 * @param OutBounds    Optional; receives the bounds of the leaf.
+	 */
+	int32 FindLeaf(const FVector& WorldPoint, FBox* OutBounds = nullptr) const;
+
+	/** Returns true if the point lies inside a blocked leaf (false outside the tree). */
+	bool IsPointBlocked(const FVector& WorldPoint) const;
+
+	/** Invokes Func(NodeIndex, Bounds) for every leaf, depth first. */
+	template <typename FuncType>
+	void ForEachLeaf(FuncType&& Func) const
+	{
+		if (Nodes.Num() > 0)
+		{
+			ForEachLeafRecursive(0, RootBounds, Func);
+		}
+	}
+
+	/** Invokes Func(NodeIndex, Bounds) for every leaf whose closed bounds intersect Box, depth first. */
+	template <typename FuncType>
+	void ForEachLeafInBox(const FBox& Box, FuncType&& Func) const
+	{
+		if (Nodes.Num() > 0)
+		{
+			ForEachLeafInBoxRecursive(0, RootBounds, Box, Func);
+		}
+	}
+
+private:
+	template <typename FuncType>
+	void ForEachLeafInBoxRecursive(int32 NodeIndex, const FBox& Bounds, const FBox& Box, FuncType& Func) const
+	{
+		if (!Bounds.Intersect(Box))
+		{
+			return;
+		}
+
+		const FNavOctreeNode& Node = Nodes[NodeIndex];
+		if (Node.IsLeaf())
+		{
+			Func(NodeIndex, Bounds);
+			return;
+		}
+
+		for (int32 Child = 0; Child < 8; ++Child)
+		{
+			ForEachLeafInBoxRecursive(Node.FirstChild + Child, GetChildBounds(Bounds, Child), Box, Func);
+		}
+	}
+
+	template <typename FuncType>
+	void ForEachLeafRecursive(int32 NodeIndex, const FBox& Bounds, FuncType& Func) const
+	{
+		const FNavOctreeNode& Node = Nodes[NodeIndex];
+		if (Node.IsLeaf())
+		{
+			Func(NodeIndex, Bounds);
+			return;
+		}
+
+		for (int32 Child = 0; Child < 8; ++Child)
+		{
+			ForEachLeafRecursive(Node.FirstChild + Child, GetChildBounds(Bounds, Child), Func);
+		}
+	}
+
+	/** Recursive helper for Build. */
+	void BuildNode(int32 NodeIndex, const FBox& Bounds, int32 Depth, TArray<FNavOctreeLeaf>& OutLeaves);
+
+	/** Recursive helper for RefineRegion. */
+	void RefineNode(int32 NodeIndex, const FBox& Bounds, int32 Depth, const FBox& Region, TArray<FNavOctreeLeaf>& OutLeaves);
+
+	/** Returns true if a node with these bounds at this depth is a leaf under the build criteria. */
+	bool IsLeafSize(const FBox& Bounds, int32 Depth) const;
+
+	/** Node arena; index 0 is the root. Children are always stored after their parent. */
+	TArray<FNavOctreeNode> Nodes;
+
+	/** World-space bounds of the root node. */
+	FBox RootBounds = FBox(ForceInit);
+
+	/** Split parameters used by Build. */
+	float MinCellSize = 1.0f;
+	int32 MaxDepth = 1;
+};
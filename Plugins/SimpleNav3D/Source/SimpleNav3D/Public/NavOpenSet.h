@@ -0,0 +1,232 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavNodeArray.h"
+
+/**
+ * FNavOpenSet
+ *
+ * Indexed 4-ary min-heap used as the A* open set.
+ * - Each node appears at most once; improving a node's score is a decrease-key
+ *   (sift-up in place) instead of pushing a duplicate entry.
+ * - Heap positions are tracked per node in an array indexed by node index (paged for
+ *   brick-storage grids, see TNavNodeArray) and stamped with a generation, so Reset is O(1)
+ *   and no memory is freed between queries.
+ * - A 4-ary layout halves the tree height compared to a binary heap; the children
+ *   of a slot are contiguous (32 bytes), so sift-down compares them in one sweep.
+ */
+struct FNavOpenSet
+{
+public:
+	/**
+	 * Prepares the set for a new query over NumNodes nodes.
+	 *
+	 * @param PagedSize  Grid size to page the positions by, or zero for a flat array (see TNavNodeArray).
+	 */
+	void Reset(int32 NumNodes, const FIntVector& PagedSize = FIntVector::ZeroValue)
+	{
+		Positions.Reset(NumNodes, PagedSize);
+
+		Heap.Reset();
+		NumPushes = 0;
+		NumPops = 0;
+		NumDecreaseKeys = 0;
+
+		++Generation;
+		if (Generation == 0)
+		{
+			// Generation counter wrapped around: clear stale stamps once.
+			Positions.ForEachElement([](FPosition& Position)
+				{
+					Position.Generation = 0;
+				});
+			Generation = 1;
+		}
+	}
+
+	/** Returns true if there are no open nodes. */
+	FORCEINLINE bool IsEmpty() const { return Heap.Num() == 0; }
+
+	/** Returns the number of open nodes. */
+	FORCEINLINE int32 Num() const { return Heap.Num(); }
+
+	/** Returns true if the node is currently in the open set. */
+	FORCEINLINE bool Contains(int32 Node) const
+	{
+		const FPosition& Position = Positions[Node];
+		return Position.Generation == Generation && Position.Slot != INDEX_NONE;
+	}
+
+	/** Returns the smallest key in the set. Set must not be empty. */
+	FORCEINLINE float GetMinKey() const { return Heap[0].Key; }
+
+	/** Returns the node with the smallest key without removing it. Set must not be empty. */
+	FORCEINLINE int32 Top() const { return Heap[0].Node; }
+
+	/** Inserts a node that is not in the set yet. */
+	void Push(int32 Node, float Key)
+	{
+		checkSlow(!Contains(Node));
+		++NumPushes;
+
+		const int32 Slot = Heap.Add(FEntry{ Key, Node });
+		Positions[Node] = FPosition{ Slot, Generation };
+		SiftUp(Slot);
+	}
+
+	/** Lowers the key of a node that is already in the set. */
+	void DecreaseKey(int32 Node, float Key)
+	{
+		checkSlow(Contains(Node));
+		const int32 Slot = Positions[Node].Slot;
+		checkSlow(Key <= Heap[Slot].Key);
+		++NumDecreaseKeys;
+
+		Heap[Slot].Key = Key;
+		SiftUp(Slot);
+	}
+
+	/** Inserts the node, or lowers its key if it is already open. */
+	FORCEINLINE void PushOrDecrease(int32 Node, float Key)
+	{
+		if (Contains(Node))
+		{
+			DecreaseKey(Node, Key);
+		}
+		else
+		{
+			Push(Node, Key);
+		}
+	}
+
+	/** Removes and returns the node with the smallest key. Set must not be empty. */
+	int32 Pop()
+	{
+		++NumPops;
+
+		const int32 Node = Heap[0].Node;
+		Positions[Node].Slot = INDEX_NONE;
+
+		const FEntry Last = Heap.Pop(EAllowShrinking::No);
+		if (Heap.Num() > 0)
+		{
+			Heap[0] = Last;
+			Positions[Last.Node].Slot = 0;
+			SiftDown(0);
+		}
+		return Node;
+	}
+
+	/** Removes a node from anywhere in the set (no-op if it is not open). */
+	void Remove(int32 Node)
+	{
+		if (!Contains(Node))
+		{
+			return;
+		}
+
+		const int32 Slot = Positions[Node].Slot;
+		Positions[Node].Slot = INDEX_NONE;
+
+		const FEntry Last = Heap.Pop(EAllowShrinking::No);
+		if (Slot < Heap.Num())
+		{
+			const float RemovedKey = Heap[Slot].Key;
+			Heap[Slot] = Last;
+			Positions[Last.Node].Slot = Slot;
+			if (Last.Key < RemovedKey)
+			{
+				SiftUp(Slot);
+			}
+			else
+			{
+				SiftDown(Slot);
+			}
+		}
+	}
+
+	/** Heap operation counters for the current query (for profiling / comparison). */
+	int32 NumPushes = 0;
+	int32 NumPops = 0;
+	int32 NumDecreaseKeys = 0;
+
+private:
+	static constexpr int32 Arity = 4;
+
+	struct FEntry
+	{
+		float Key;
+		int32 Node;
+	};
+
+	struct FPosition
+	{
+		/** Heap slot of the node, or INDEX_NONE once popped. */
+		int32 Slot = INDEX_NONE;
+
+		/** Query generation this slot belongs to. */
+		uint32 Generation = 0;
+	};
+
+	void SiftUp(int32 Slot)
+	{
+		const FEntry Entry = Heap[Slot];
+		while (Slot > 0)
+		{
+			const int32 ParentSlot = (Slot - 1) / Arity;
+			if (!(Entry.Key < Heap[ParentSlot].Key))
+			{
+				break;
+			}
+			Heap[Slot] = Heap[ParentSlot];
+			Positions[Heap[Slot].Node].Slot = Slot;
+			Slot = ParentSlot;
+		}
+		Heap[Slot] = Entry;
+		Positions[Entry.Node].Slot = Slot;
+	}
+
+	void SiftDown(int32 Slot)
+	{
+		const FEntry Entry = Heap[Slot];
+		const int32 Count = Heap.Num();
+		while (true)
+		{
+			const int32 FirstChild = Slot * Arity + 1;
+			if (FirstChild >= Count)
+			{
+				break;
+			}
+
+			// Pick the smallest of up to Arity children
+			int32 BestChild = FirstChild;
+			const int32 LastChild = FMath::Min(FirstChild + Arity, Count);
+			for (int32 Child = FirstChild + 1; Child < LastChild; ++Child)
+			{
+				if (Heap[Child].Key < Heap[BestChild].Key)
+				{
+					BestChild = Child;
+				}
+			}
+
+			if (!(Heap[BestChild].Key < Entry.Key))
+			{
+				break;
+			}
+			Heap[Slot] = Heap[BestChild];
+			Positions[Heap[Slot].Node].Slot = Slot;
+			Slot = BestChild;
+		}
+		Heap[Slot] = Entry;
+		Positions[Entry.Node].Slot = Slot;
+	}
+
+	/** Heap storage; keeps its capacity between queries. */
+	TArray<FEntry> Heap;
+
+	/** Heap slot per node index, generation-stamped. */
+	TNavNodeArray<FPosition> Positions;
+
+	/** Current query generation. 0 is reserved for "never touched". */
+	uint32 Generation = 0;
+};
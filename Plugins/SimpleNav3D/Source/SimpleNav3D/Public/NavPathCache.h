@@ -0,0 +1,166 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FNavGrid;
+
+/**
+ * Identifies a cached path: requested start and goal cells plus everything else the result depends on.
+ */
+struct FNavPathCacheKey
+{
+	/** Start cell. */
+	int32 StartCell = INDEX_NONE;
+
+	/** Requested goal cell (before relocation to a free cell). */
+	int32 GoalCell = INDEX_NONE;
+
+	/** Agent size class, as a clearance requirement. */
+	int32 RequiredClearance = 0;
+
+	/** Bit per EObjectTypeQuery treated as an obstacle (64 bits, so ObjectTypeQuery_MAX has one too). */
+	uint64 ObjectTypeMask = 0;
+
+	bool operator==(const FNavPathCacheKey& Other) const
+	{
+		return StartCell == Other.StartCell
+			&& GoalCell == Other.GoalCell
+			&& RequiredClearance == Other.RequiredClearance
+			&& ObjectTypeMask == Other.ObjectTypeMask;
+	}
+
+	friend uint32 GetTypeHash(const FNavPathCacheKey& Key)
+	{
+		return HashCombine(HashCombine(GetTypeHash(Key.StartCell), GetTypeHash(Key.GoalCell)), HashCombine(GetTypeHash(Key.RequiredClearance), GetTypeHash(Key.ObjectTypeMask)));
+	}
+};
+
+/**
+ * FNavPathCache
+ *
+ * Least recently used cache of grid paths (cell indices), for agents repeating near-identical queries.
+ * - The grid is split into cubic regions, each with a change stamp. InvalidateCells stamps the
+ *   regions of a changed cell range; nothing is searched or freed at that point.
+ * - An entry remembers the regions its path crosses (segments between waypoints included) and
+ *   when it was stored. It is served only if none of those regions changed since, otherwise it is
+ *   dropped on lookup and counted as a miss.
+ * - Changes outside a path's regions keep it valid, even if they open a shorter route.
+ * - Entries live in one array linked in recency order; the least recently used one is reused when full.
+ */
+class SIMPLENAV3D_API FNavPathCache
+{
+public:
+	/**
+	 * Sizes an empty cache for a grid. Clears entries and statistics.
+	 *
+	 * @param InGridSize    Grid size in cells.
+	 * @param InRegionSize  Side length of an invalidation region in cells.
+	 * @param InCapacity    Maximum number of cached paths.
+	 */
+	void Init(const FIntVector& InGridSize, int32 InRegionSize, int32 InCapacity);
+
+	/** Releases all storage. */
+	void Reset();
+
+	/** Drops all entries; statistics are kept. */
+	void Empty();
+
+	/** Returns true once Init has been called with a non-empty grid and capacity. */
+	FORCEINLINE bool IsInitialized() const { return Capacity > 0; }
+
+	/**
+	 * Returns the cached path for a key and marks it most recently used, or nullptr if there is no
+	 * valid entry. Counts a hit or a miss.
+	 */
+	const TArray<int32>* Find(const FNavPathCacheKey& Key);
+
+	/**
+	 * Stores a path, replacing any entry for the key and evicting the least recently used one if full.
+	 *
+	 * @param Key        Query the path answers.
+	 * @param Grid       Grid the path was found on (must match the size given to Init).
+	 * @param PathNodes  Path cells, start first; its last cell is the (possibly relocated) goal.
+	 */
+	void Add(const FNavPathCacheKey& Key, const FNavGrid& Grid, const TArray<int32>& PathNodes);
+
+	/** Invalidates every entry whose path crosses a region overlapping the inclusive cell range (clamped to the grid). */
+	void InvalidateCells(const FIntVector& Min, const FIntVector& Max);
+
+	/** Returns the number of stored entries (stale ones included until they are looked up or evicted). */
+	FORCEINLINE int32 Num() const { return EntryMap.Num(); }
+
+	/** Returns the number of lookups served from the cache since Init or ResetStats. */
+	FORCEINLINE int64 GetNumHits() const { return NumHits; }
+
+	/** Returns the number of lookups that found no valid entry since Init or ResetStats. */
+	FORCEINLINE int64 GetNumMisses() const { return NumMisses; }
+
+	/** Zeroes the hit and miss counters. */
+	FORCEINLINE void ResetStats() { NumHits = 0; NumMisses = 0; }
+
+private:
+	/** One cached path, linked into the recency list. */
+	struct FEntry
+	{
+		FNavPathCacheKey Key;
+		TArray<int32> PathNodes;
+
+		/** Regions the path crosses, sorted and unique. */
+		TArray<int32> Regions;
+
+		/** Change stamp when the entry was stored. */
+		uint64 Stamp = 0;
+
+		/** Neighbours in the recency list (Prev is more recent). */
+		int32 Prev = INDEX_NONE;
+		int32 Next = INDEX_NONE;
+	};
+
+	/** Returns true if no region of the entry changed after it was stored. */
+	bool IsEntryValid(const FEntry& Entry) const;
+
+	/** Returns the region containing a cell. */
+	FORCEINLINE int32 GetRegionIndex(const FIntVector& Cell) const
+	{
+		return (Cell.X / RegionSize) + (Cell.Y / RegionSize) * NumRegions.X + (Cell.Z / RegionSize) * NumRegions.X * NumRegions.Y;
+	}
+
+	/** Appends the regions a straight segment between two cells passes through (conservatively). */
+	void AddSegmentRegions(const FIntVector& From, const FIntVector& To, TArray<int32>& OutRegions) const;
+
+	/** Unlinks an entry from the recency list. */
+	void Unlink(int32 EntryIndex);
+
+	/** Links an entry at the most recent end of the recency list. */
+	void LinkFront(int32 EntryIndex);
+
+	/** Removes an entry from the map and the recency list and frees its slot. */
+	void RemoveEntry(int32 EntryIndex);
+
+	/** Grid size in cells, region side length in cells and region counts per axis. */
+	FIntVector GridSize = FIntVector::ZeroValue;
+	int32 RegionSize = 1;
+	FIntVector NumRegions = FIntVector::ZeroValue;
+
+	/** Maximum number of entries. */
+	int32 Capacity = 0;
+
+	/** Stamp of the last change per region; entries stored later than it are unaffected. */
+	TArray<uint64> RegionStamps;
+
+	/** Incremented by every invalidation. */
+	uint64 CurrentStamp = 0;
+
+	/** Entry storage, slots free for reuse and lookup by key. */
+	TArray<FEntry> Entries;
+	TArray<int32> FreeEntries;
+	TMap<FNavPathCacheKey, int32> EntryMap;
+
+	/** Most and least recently used entries. */
+	int32 Head = INDEX_NONE;
+	int32 Tail = INDEX_NONE;
+
+	/** Lookup statistics. */
+	int64 NumHits = 0;
+	int64 NumMisses = 0;
+};
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavPathTypes.generated.h"
+
+class AActor;
+
+/**
+ * Scheduling priority of an asynchronous path request.
+ * Queued requests are dispatched highest priority first, FIFO within a priority.
+ */
+UENUM(BlueprintType)
+enum class EPathRequestPriority : uint8
+{
+	/** Dispatched only when no Normal or High requests are waiting. */
+	EPRP_Low     UMETA(DisplayName = "Low"),
+
+	/** Default priority. */
+	EPRP_Normal  UMETA(DisplayName = "Normal"),
+
+	/** Dispatched before all other waiting requests. */
+	EPRP_High    UMETA(DisplayName = "High"),
+};
+
+/**
+ * Called on the game thread when an asynchronous path request finishes.
+ * Cancelled requests never fire their callback.
+ *
+ * @param RequestId  Id returned by RequestPathAsync.
+ * @param bSuccess   Whether a path was found.
+ * @param Path       World-space points of the path (empty on failure).
+ */
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FOnNavPathRequestComplete, int32, RequestId, bool, bSuccess, const TArray<FVector>&, Path);
+
+/**
+ * Graph searched by the synchronous FindPath.
+ */
+UENUM(BlueprintType)
+enum class ENavSearchMode : uint8
+{
+	/** A* over the uniform grid cells (one node per cell). */
+	ENSM_Grid          UMETA(DisplayName = "Grid"),
+
+	/** A* over the free octree leaves (one node per leaf, few nodes in open space). */
+	ENSM_SparseVoxel   UMETA(DisplayName = "Sparse Voxel Octree"),
+
+	/**
+	 * Jump point search over the grid cells: same path cost as Grid, far fewer expansions in open space.
+	 * Requires 26-connectivity (MinSharedNeighborAxes = 0); falls back to Grid otherwise
+	 * and for queries with dynamic overlap checks.
+	 */
+	ENSM_JumpPoint     UMETA(DisplayName = "Grid (Jump Point Search)"),
+
+	/**
+	 * Hierarchical A* (HPA*): plans over precomputed cluster transitions, then searches only the clusters
+	 * along that plan. Query cost barely grows with distance; paths are near optimal.
+	 * Queries with dynamic overlap checks fall back to Grid.
+	 */
+	ENSM_Hierarchical  UMETA(DisplayName = "Hierarchical (HPA*)"),
+
+	/**
+	 * Any-angle search (Lazy Theta*) over the grid cells: waypoints connect any cells in line of sight,
+	 * so paths are shorter than 26-direction staircases and have few points. Also used by async requests.
+	 */
+	ENSM_AnyAngle      UMETA(DisplayName = "Grid (Any-Angle Theta*)"),
+
+	/**
+	 * Bidirectional A* (NBA*) over the grid cells: searches from both ends and meets in the middle.
+	 * Same path cost as Grid, fewer expansions on long routes whose goal side is enclosed (caves,
+	 * corridors). Used by the synchronous FindPath; async, sliced and batch requests run Grid A*.
+	 */
+	ENSM_Bidirectional UMETA(DisplayName = "Grid (Bidirectional A*)"),
+};
+
+/**
+ * Outcome of one query of a path batch (see AOctNavVolume3D::FindPathsBatch).
+ */
+UENUM(BlueprintType)
+enum class ENavBatchPathStatus : uint8
+{
+	/** A path was found. */
+	ENBPS_Succeeded    UMETA(DisplayName = "Succeeded"),
+
+	/** The search ran out of reachable nodes before reaching the goal. */
+	ENBPS_NoPath       UMETA(DisplayName = "No Path"),
+
+	/** No free cell the agent fits in was found near the destination. */
+	ENBPS_NoFreeGoal   UMETA(DisplayName = "No Free Goal"),
+
+	/** The grid was not built, so nothing was searched. */
+	ENBPS_NotReady     UMETA(DisplayName = "Not Ready"),
+};
+
+/**
+ * One query of a path batch: start, goal and agent parameters.
+ */
+USTRUCT(BlueprintType)
+struct FNavBatchPathQuery
+{
+	GENERATED_BODY()
+
+	/** World-space start location. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SimpleOctaNavVolume3D")
+	FVector Start = FVector::ZeroVector;
+
+	/** World-space goal location (relocated to the nearest free cell if needed). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SimpleOctaNavVolume3D")
+	FVector Destination = FVector::ZeroVector;
+
+	/** Agent capsule radius (clearance requirement). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SimpleOctaNavVolume3D")
+	float DetectionRadius = 34.f;
+
+	/** Agent capsule half-height (clearance requirement). */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SimpleOctaNavVolume3D")
+	float DetectionHalfHeight = 44.f;
+
+	/** Optional requesting actor; if it is a registered dynamic obstacle, its own cells are ignored. */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SimpleOctaNavVolume3D")
+	TObjectPtr<AActor> Actor = nullptr;
+};
+
+/**
+ * Result of one query of a path batch, at the same index as its query.
+ */
+USTRUCT(BlueprintType)
+struct FNavBatchPathResult
+{
+	GENERATED_BODY()
+
+	/** Whether a path was found, and why not otherwise. */
+	UPROPERTY(BlueprintReadOnly, Category = "SimpleOctaNavVolume3D")
+	ENavBatchPathStatus Status = ENavBatchPathStatus::ENBPS_NotReady;
+
+	/** Number of nodes the search expanded (for profiling). */
+	UPROPERTY(BlueprintReadOnly, Category = "SimpleOctaNavVolume3D")
+	int32 NumExpanded = 0;
+
+	/** World-space cell centers of the path, start first (empty on failure). */
+	UPROPERTY(BlueprintReadOnly, Category = "SimpleOctaNavVolume3D")
+	TArray<FVector> Path;
+};
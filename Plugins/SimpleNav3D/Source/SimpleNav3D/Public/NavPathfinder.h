@@ -0,0 +1,1035 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavGrid.h"
+#include "NavSearchContext.h"
+#include <atomic>
+#include <type_traits>
+
+/**
+ * Parameters of a single grid search.
+ */
+struct FNavPathQuery
+{
+	/** Linear index of the start cell. */
+	int32 StartNode = INDEX_NONE;
+
+	/** Linear index of the goal cell. */
+	int32 GoalNode = INDEX_NONE;
+
+	/** Clearance (in cells) every cell on the path must have, see FNavGrid::GetRequiredClearance. */
+	int32 RequiredClearance = 1;
+
+	/**
+	 * Use jump point search instead of plain A* (same path cost, far fewer expansions in open space).
+	 * Only honoured on 26-connected grids and for queries without a cell filter.
+	 */
+	bool bUseJumpPoints = false;
+
+	/**
+	 * Any-angle search (Lazy Theta*): a cell's parent may be any earlier cell in line of sight,
+	 * so the path is a short list of waypoints instead of one entry per cell. Works with cell filters.
+	 */
+	bool bAnyAngle = false;
+
+	/** Remove waypoints not needed to keep line of sight (string pulling) once a path is found. */
+	bool bSmoothPath = false;
+
+	/** Optional flag polled during the search; the search gives up once it is set. */
+	const std::atomic<bool>* CancelFlag = nullptr;
+
+	/** Default of GoalSearchRadius and of FNavPathfinder::FindNearestFreeNode's bound. */
+	static constexpr int32 DefaultGoalSearchRadius = 16;
+
+	/** How far (in cells) request services look for a free cell when the agent does not fit at the goal. */
+	int32 GoalSearchRadius = DefaultGoalSearchRadius;
+};
+
+/**
+ * State of a resumable search (see FNavPathfinder::StepGraphPath).
+ */
+enum class ENavSearchStatus : uint8
+{
+	/** The step budget ran out; call StepGraphPath again. */
+	InProgress,
+
+	/** A path was found. */
+	Succeeded,
+
+	/** No path exists, or the search was cancelled. */
+	Failed,
+};
+
+/**
+ * FNavPathfinder
+ *
+ * Stateless A* (over an FNavGrid or any graph with the same shape), 3D jump point search,
+ * any-angle search with grid line of sight, path smoothing and nearest-free-cell search.
+ * - The grid is only read; all mutable state lives in the caller's FNavSearchContext,
+ *   so any number of searches may run concurrently on one grid, one context each.
+ * - An optional cell filter refines the clearance test (e.g. physics overlap checks).
+ *   It is only invoked for cells that already pass the clearance test, and in A* only
+ *   when a cheaper path to the cell was found, to keep expensive checks to a minimum.
+ */
+struct FNavPathfinder
+{
+	/** Cell filter that accepts every cell. */
+	struct FAcceptAllCells
+	{
+		FORCEINLINE bool operator()(int32) const { return true; }
+	};
+
+	/** Number of expansions between two polls of FNavPathQuery::CancelFlag. */
+	static constexpr int32 CancelPollInterval = 256;
+
+	/**
+	 * Runs A* over any graph exposing:
+	 *  - int32 GetNumNodes() const
+	 *  - FIntVector GetPagedSize() const, the grid size to page search state by for grid cells (zero otherwise)
+	 *  - void ForEachNeighbour(int32 Node, Func) const, calling Func(int32 Neighbour, float Cost)
+	 *    for every neighbour the agent may traverse to
+	 *  - float GetHeuristic(int32 Node) const, an admissible estimate of the remaining cost to the goal
+	 * On success the path (start first) is left in Context.PathNodes.
+	 *
+	 * @param Graph       Graph to search (read only).
+	 * @param Context     Scratch state owned by the calling thread.
+	 * @param StartNode   Node the search starts from.
+	 * @param GoalNode    Node to reach.
+	 * @param CancelFlag  Optional flag polled during the search; the search gives up once it is set.
+	 * @param NodeFilter  Callable bool(int32 Node) returning false to reject a node.
+	 *
+	 * @return true if a path was found, false if none exists or the search was cancelled.
+	 */
+	template <typename GraphType, typename NodeFilterType = FAcceptAllCells>
+	static bool FindGraphPath(
+		const GraphType& Graph,
+		FNavSearchContext& Context,
+		int32 StartNode,
+		int32 GoalNode,
+		const std::atomic<bool>* CancelFlag = nullptr,
+		NodeFilterType&& NodeFilter = NodeFilterType())
+	{
+		BeginGraphPath(Graph, Context, StartNode);
+		return StepGraphPath(Graph, Context, GoalNode, 0, CancelFlag, NodeFilter) == ENavSearchStatus::Succeeded;
+	}
+
+	/**
+	 * Starts a resumable A* search: the first half of FindGraphPath. The search then advances with
+	 * StepGraphPath; all of its state stays in Context between steps.
+	 */
+	template <typename GraphType>
+	static void BeginGraphPath(const GraphType& Graph, FNavSearchContext& Context, int32 StartNode)
+	{
+		// -------------------------------------------------------
+		// A* Setup
+		// -------------------------------------------------------
+		// All per-query state lives in the reusable context, indexed by
+		// node index, so no containers are allocated here.
+		Context.BeginSearch(Graph.GetNumNodes(), Graph.GetPagedSize());
+
+		// Initialize start node
+		Context.Touch(StartNode).GScore = 0.0f;
+		Context.OpenSet.Push(StartNode, Graph.GetHeuristic(StartNode));
+	}
+
+	/**
+	 * Advances a search started with BeginGraphPath. The graph may be a new instance between steps, but
+	 * must describe the same nodes and goal. Parameters match FindGraphPath, plus:
+	 *
+	 * @param MaxExpansions  Expansion budget of this step; 0 or less runs until the search ends.
+	 *
+	 * @return InProgress if the budget ran out first; Succeeded leaves the path in Context.PathNodes.
+	 */
+	template <typename GraphType, typename NodeFilterType = FAcceptAllCells>
+	static ENavSearchStatus StepGraphPath(
+		const GraphType& Graph,
+		FNavSearchContext& Context,
+		int32 GoalNode,
+		int32 MaxExpansions,
+		const std::atomic<bool>* CancelFlag = nullptr,
+		NodeFilterType&& NodeFilter = NodeFilterType())
+	{
+		FNavOpenSet& OpenSet = Context.OpenSet;
+		const int32 ExpansionLimit = Context.NumExpanded + MaxExpansions;
+
+		// -------------------------------------------------------
+		// A* Main Loop
+		// -------------------------------------------------------
+		while (!OpenSet.IsEmpty())
+		{
+			// Out of budget: the open set and node states carry over to the next step
+			if (MaxExpansions > 0 && Context.NumExpanded >= ExpansionLimit)
+			{
+				return ENavSearchStatus::InProgress;
+			}
+
+			const int32 CurrentNode = OpenSet.Pop();
+
+			// Every node is in the open set at most once, so a popped node is never stale
+			FNavSearchNode& CurrentState = Context.Touch(CurrentNode);
+			CurrentState.bClosed = true;
+			++Context.NumExpanded;
+
+			// Goal reached: reconstruct path (append along parents, then reverse)
+			if (CurrentNode == GoalNode)
+			{
+				Context.BuildPath(CurrentNode);
+				return ENavSearchStatus::Succeeded;
+			}
+
+			// Give up if the owner no longer wants the result
+			if (CancelFlag && (Context.NumExpanded % CancelPollInterval) == 0
+				&& CancelFlag->load(std::memory_order_relaxed))
+			{
+				return ENavSearchStatus::Failed;
+			}
+
+			const float CurrentGScore = CurrentState.GScore;
+
+			Graph.ForEachNeighbour(CurrentNode, [&](int32 Neighbour, float EdgeCost)
+				{
+					if (Context.IsClosed(Neighbour))
+					{
+						return;
+					}
+
+					const float TentativeG = CurrentGScore + EdgeCost;
+					const float ExistingScore = Context.GetGScore(Neighbour);
+
+					// Found a cheaper path to this neighbour
+					if (TentativeG < ExistingScore)
+					{
+						// Optional refinement (e.g., dynamic overlaps with other actors or obstacles)
+						if (!NodeFilter(Neighbour))
+						{
+							return;
+						}
+
+						FNavSearchNode& NeighbourState = Context.Touch(Neighbour);
+						NeighbourState.Parent = CurrentNode;
+						NeighbourState.GScore = TentativeG;
+
+						// Insert, or decrease-key in place if the neighbour is already open
+						OpenSet.PushOrDecrease(Neighbour, TentativeG + Graph.GetHeuristic(Neighbour));
+					}
+				});
+		}
+
+		// No path found
+		return ENavSearchStatus::Failed;
+	}
+
+	/**
+	 * The grid as an A* graph for one query: implicit neighbours filtered by clearance,
+	 * edge cost is the Euclidean offset length, heuristic is the Euclidean distance in grid space.
+	 */
+	struct FGridGraph
+	{
+		FGridGraph(const FNavGrid& InGrid, int32 InRequiredClearance, int32 InGoalNode)
+			: Grid(InGrid)
+			, RequiredClearance(InRequiredClearance)
+			, GoalCoordinates(InGrid.GetCoordinates(InGoalNode))
+		{
+		}
+
+		FORCEINLINE int32 GetNumNodes() const { return Grid.GetNumCells(); }
+
+		FORCEINLINE FIntVector GetPagedSize() const { return Grid.GetSearchPagedSize(); }
+
+		FORCEINLINE float GetHeuristic(int32 Node) const
+		{
+			return FVector::Distance(FVector(Grid.GetCoordinates(Node)), GoalCoordinates);
+		}
+
+		template <typename FuncType>
+		FORCEINLINE void ForEachNeighbour(int32 Node, FuncType&& Func) const
+		{
+			Grid.ForEachNeighbour(Node, [this, &Func](int32 Neighbour, float EdgeCost)
+				{
+					// Skip neighbours the agent does not fit in (one byte compare, no octree descent or physics)
+					if (Grid.IsPassable(Neighbour, RequiredClearance))
+					{
+						Func(Neighbour, EdgeCost);
+					}
+				});
+		}
+
+		const FNavGrid& Grid;
+		int32 RequiredClearance;
+		FVector GoalCoordinates;
+	};
+
+	/**
+	 * Jump point search (JPS-3D) over a 26-connected, uniform-cost grid.
+	 * Successors of a node are the jump points reached by scanning along the natural directions of
+	 * the move that led to it (every non-empty subset of its non-zero axes); a scan stops at the goal,
+	 * at a cell next to a cell the agent cannot occupy, or, for diagonal scans, at a cell from which
+	 * a lower-dimensional scan finds a jump point. Cells next to an obstacle (and the start) are
+	 * expanded in all 26 directions, which covers every forced neighbour.
+	 * Edge costs are the scanned distance, so A* over jump points returns a path of the same cost as
+	 * A* over cells; FindPath expands it back to consecutive cells.
+	 */
+	struct FJumpPointGraph
+	{
+		FJumpPointGraph(const FNavGrid& InGrid, const FNavSearchContext& InContext, int32 InRequiredClearance, int32 InGoalNode)
+			: Grid(InGrid)
+			, Context(InContext)
+			, RequiredClearance(InRequiredClearance)
+			, GoalNode(InGoalNode)
+			, GoalCoordinates(InGrid.GetCoordinates(InGoalNode))
+		{
+		}
+
+		FORCEINLINE int32 GetNumNodes() const { return Grid.GetNumCells(); }
+
+		FORCEINLINE FIntVector GetPagedSize() const { return Grid.GetSearchPagedSize(); }
+
+		FORCEINLINE float GetHeuristic(int32 Node) const
+		{
+			return FVector::Distance(FVector(Grid.GetCoordinates(Node)), GoalCoordinates);
+		}
+
+		template <typename FuncType>
+		void ForEachNeighbour(int32 Node, FuncType&& Func) const
+		{
+			const FIntVector Coordinates = Grid.GetCoordinates(Node);
+			const int32 Parent = Context.GetParent(Node);
+
+			// Start node, or next to an obstacle: scan in every direction
+			if (Parent == INDEX_NONE || !IsOpen(Coordinates, Node))
+			{
+				for (const FNavGridNeighbour& Neighbour : Grid.GetNeighbourOffsets())
+				{
+					JumpFrom(Coordinates, Neighbour.Offset, Func);
+				}
+				return;
+			}
+
+			// Open neighbourhood: only the natural directions of the incoming move
+			const FIntVector Direction = GetDirection(Grid.GetCoordinates(Parent), Coordinates);
+			const int32 AxisMask = GetAxisMask(Direction);
+			for (int32 SubMask = AxisMask; SubMask > 0; SubMask = (SubMask - 1) & AxisMask)
+			{
+				JumpFrom(Coordinates, MaskDirection(Direction, SubMask), Func);
+			}
+		}
+
+	private:
+		/** Unit step (-1, 0 or 1 per axis) from one cell towards another along a straight or diagonal line. */
+		static FORCEINLINE FIntVector GetDirection(const FIntVector& From, const FIntVector& To)
+		{
+			return FIntVector(FMath::Sign(To.X - From.X), FMath::Sign(To.Y - From.Y), FMath::Sign(To.Z - From.Z));
+		}
+
+		/** Bit per non-zero axis of a direction (bit 0 = X, bit 1 = Y, bit 2 = Z). */
+		static FORCEINLINE int32 GetAxisMask(const FIntVector& Direction)
+		{
+			return (Direction.X != 0 ? 1 : 0) | (Direction.Y != 0 ? 2 : 0) | (Direction.Z != 0 ? 4 : 0);
+		}
+
+		/** Keeps only the axes of a direction selected by Mask. */
+		static FORCEINLINE FIntVector MaskDirection(const FIntVector& Direction, int32 Mask)
+		{
+			return FIntVector((Mask & 1) ? Direction.X : 0, (Mask & 2) ? Direction.Y : 0, (Mask & 4) ? Direction.Z : 0);
+		}
+
+		/** Euclidean length of a unit step with the given number of non-zero axes. */
+		static FORCEINLINE float GetStepCost(int32 AxisMask)
+		{
+			static const float StepCosts[] = { 0.0f, 1.0f, 1.0f, UE_SQRT_2, 1.0f, UE_SQRT_2, UE_SQRT_2, UE_SQRT_3 };
+			return StepCosts[AxisMask];
+		}
+
+		/**
+		 * Returns true if every in-bounds neighbour of the cell can be occupied by the agent.
+		 * Clearance is 1-Lipschitz, so a cell with more than the required clearance needs no neighbour test.
+		 */
+		bool IsOpen(const FIntVector& Coordinates, int32 Index) const
+		{
+			if (Grid.HasClearanceLayer() && Grid.GetClearance(Index) > RequiredClearance)
+			{
+				return true;
+			}
+
+			// Out-of-bounds cells never force a neighbour: any detour around them would leave the grid too
+			for (const FNavGridNeighbour& Neighbour : Grid.GetNeighbourOffsets())
+			{
+				if (Grid.IsValidCoordinates(Coordinates + Neighbour.Offset)
+					&& !Grid.IsPassable(Index + Neighbour.IndexDelta, RequiredClearance))
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		/**
+		 * Scans from a cell along a direction and returns the first jump point, or INDEX_NONE
+		 * if the scan runs into an impassable cell or the grid boundary.
+		 */
+		int32 Jump(const FIntVector& From, const FIntVector& Direction, int32& OutSteps) const
+		{
+			const int32 AxisMask = GetAxisMask(Direction);
+			FIntVector Coordinates = From;
+			for (int32 Steps = 1; ; ++Steps)
+			{
+				Coordinates += Direction;
+				if (!Grid.IsValidCoordinates(Coordinates))
+				{
+					return INDEX_NONE;
+				}
+
+				const int32 Index = Grid.GetIndex(Coordinates);
+				if (!Grid.IsPassable(Index, RequiredClearance))
+				{
+					return INDEX_NONE;
+				}
+
+				OutSteps = Steps;
+				if (Index == GoalNode || !IsOpen(Coordinates, Index))
+				{
+					return Index;
+				}
+
+				// Diagonal scan: stop where any lower-dimensional natural direction leads somewhere
+				for (int32 SubMask = (AxisMask - 1) & AxisMask; SubMask > 0; SubMask = (SubMask - 1) & AxisMask)
+				{
+					int32 SubSteps = 0;
+					if (Jump(Coordinates, MaskDirection(Direction, SubMask), SubSteps) != INDEX_NONE)
+					{
+						return Index;
+					}
+				}
+			}
+		}
+
+		/** Reports the jump point along a direction, if any, with the cost of the scanned segment. */
+		template <typename FuncType>
+		FORCEINLINE void JumpFrom(const FIntVector& From, const FIntVector& Direction, FuncType& Func) const
+		{
+			int32 Steps = 0;
+			const int32 JumpPoint = Jump(From, Direction, Steps);
+			if (JumpPoint != INDEX_NONE)
+			{
+				Func(JumpPoint, GetStepCost(GetAxisMask(Direction)) * Steps);
+			}
+		}
+
+		const FNavGrid& Grid;
+		const FNavSearchContext& Context;
+		int32 RequiredClearance;
+		int32 GoalNode;
+		FVector GoalCoordinates;
+	};
+
+	/**
+	 * Replaces a path of jump points (consecutive points on one straight or diagonal line)
+	 * with every cell along it, in place.
+	 */
+	static void ExpandJumpPoints(const FNavGrid& Grid, TArray<int32>& PathNodes)
+	{
+		if (PathNodes.Num() < 2)
+		{
+			return;
+		}
+
+		// Segment lengths are Chebyshev distances; grow once, then fill from the back
+		const int32 NumJumpPoints = PathNodes.Num();
+		int32 NumCells = 1;
+		for (int32 Index = 1; Index < NumJumpPoints; ++Index)
+		{
+			const FIntVector Delta = Grid.GetCoordinates(PathNodes[Index]) - Grid.GetCoordinates(PathNodes[Index - 1]);
+			NumCells += FMath::Max3(FMath::Abs(Delta.X), FMath::Abs(Delta.Y), FMath::Abs(Delta.Z));
+		}
+
+		PathNodes.SetNum(NumCells, EAllowShrinking::No);
+		int32 Write = NumCells - 1;
+		for (int32 Index = NumJumpPoints - 1; Index > 0; --Index)
+		{
+			const FIntVector To = Grid.GetCoordinates(PathNodes[Index]);
+			const FIntVector From = Grid.GetCoordinates(PathNodes[Index - 1]);
+			const FIntVector Step(FMath::Sign(From.X - To.X), FMath::Sign(From.Y - To.Y), FMath::Sign(From.Z - To.Z));
+			for (FIntVector Cell = To; Cell != From; Cell += Step)
+			{
+				PathNodes[Write--] = Grid.GetIndex(Cell);
+			}
+		}
+		check(Write == 0);
+	}
+
+	/**
+	 * Runs A* (or jump point search, see FNavPathQuery::bUseJumpPoints, or any-angle search,
+	 * see FNavPathQuery::bAnyAngle) over the grid from Query.StartNode to Query.GoalNode.
+	 * On success the path (start first) is left in Context.PathNodes: one entry per cell,
+	 * or waypoints in line of sight of each other for any-angle and smoothed queries.
+	 *
+	 * @param Grid        Grid to search (read only).
+	 * @param Context     Scratch state owned by the calling thread.
+	 * @param Query       Start, goal, clearance, search variant and cancellation flag.
+	 * @param CellFilter  Callable bool(int32 Cell) returning false to reject a cell.
+	 *
+	 * @return true if a path was found, false if none exists or the search was cancelled.
+	 */
+	template <typename CellFilterType = FAcceptAllCells>
+	static bool FindPath(
+		const FNavGrid& Grid,
+		FNavSearchContext& Context,
+		const FNavPathQuery& Query,
+		CellFilterType&& CellFilter = CellFilterType())
+	{
+		if (Query.bAnyAngle)
+		{
+			return FindAnyAnglePath(Grid, Context, Query, CellFilter);
+		}
+
+		// Jumps skip the cells they scan over, so a cell filter could not see them: filtered queries use A*
+		if constexpr (std::is_same_v<std::decay_t<CellFilterType>, FAcceptAllCells>)
+		{
+			if (Query.bUseJumpPoints && SupportsJumpPoints(Grid))
+			{
+				const FJumpPointGraph Graph(Grid, Context, Query.RequiredClearance, Query.GoalNode);
+				if (!FindGraphPath(Graph, Context, Query.StartNode, Query.GoalNode, Query.CancelFlag))
+				{
+					return false;
+				}
+				ExpandJumpPoints(Grid, Context.PathNodes);
+				if (Query.bSmoothPath)
+				{
+					SmoothPath(Grid, Context.PathNodes, Query.RequiredClearance);
+				}
+				return true;
+			}
+		}
+
+		const FGridGraph Graph(Grid, Query.RequiredClearance, Query.GoalNode);
+		if (!FindGraphPath(Graph, Context, Query.StartNode, Query.GoalNode, Query.CancelFlag, CellFilter))
+		{
+			return false;
+		}
+		if (Query.bSmoothPath)
+		{
+			SmoothPath(Grid, Context.PathNodes, Query.RequiredClearance, CellFilter);
+		}
+		return true;
+	}
+
+	/**
+	 * Bidirectional A* (NBA*) over the grid cells: one search from the start toward the goal and one
+	 * from the goal toward the start, over the same neighbour relation, meeting in the middle.
+	 * - Both directions share one set of finished nodes; a node either direction pops is never
+	 *   expanded again, and a popped node is dropped without expansion once its own f-value, or its
+	 *   g-value plus the other direction's lowest f-value minus its heuristic toward the other end,
+	 *   shows it cannot lie on a path shorter than the best one met so far.
+	 * - The side with the smaller open set expands next. The search ends when either open set runs
+	 *   empty; the best meeting path is then optimal (same cost as A*).
+	 * On long corridor-like routes each direction covers about half the distance, so the two searches
+	 * together expand far fewer cells than one. Query.bUseJumpPoints and Query.bAnyAngle are ignored.
+	 * On success the path (start first) is left in Forward.PathNodes.
+	 *
+	 * @param Forward     Scratch state of the search from the start (also receives the path).
+	 * @param Backward    Scratch state of the search from the goal; a second context owned by the calling thread.
+	 *
+	 * Other parameters and the return value match FindPath.
+	 */
+	template <typename CellFilterType = FAcceptAllCells>
+	static bool FindBidirectionalPath(
+		const FNavGrid& Grid,
+		FNavSearchContext& Forward,
+		FNavSearchContext& Backward,
+		const FNavPathQuery& Query,
+		CellFilterType&& CellFilter = CellFilterType())
+	{
+		const int32 StartNode = Query.StartNode;
+		const int32 GoalNode = Query.GoalNode;
+
+		Forward.BeginSearch(Grid.GetNumCells(), Grid.GetSearchPagedSize());
+		Backward.BeginSearch(Grid.GetNumCells(), Grid.GetSearchPagedSize());
+
+		if (StartNode == GoalNode)
+		{
+			Forward.BuildPath(StartNode);
+			return true;
+		}
+
+		// Plain A* only reaches a goal the agent fits in (the start is exempt)
+		if (!Grid.IsPassable(GoalNode, Query.RequiredClearance) || !CellFilter(GoalNode))
+		{
+			return false;
+		}
+
+		// Heuristic of each direction: distance to the other end
+		const FGridGraph ForwardGraph(Grid, Query.RequiredClearance, GoalNode);
+		const FGridGraph BackwardGraph(Grid, Query.RequiredClearance, StartNode);
+
+		Forward.Touch(StartNode).GScore = 0.0f;
+		Forward.OpenSet.Push(StartNode, ForwardGraph.GetHeuristic(StartNode));
+		Backward.Touch(GoalNode).GScore = 0.0f;
+		Backward.OpenSet.Push(GoalNode, BackwardGraph.GetHeuristic(GoalNode));
+
+		// Cost of the best path met so far, and the cell where its two halves meet
+		float BestCost = MAX_flt;
+		int32 MeetingNode = INDEX_NONE;
+
+		while (!Forward.OpenSet.IsEmpty() && !Backward.OpenSet.IsEmpty())
+		{
+			const bool bForward = Forward.OpenSet.Num() <= Backward.OpenSet.Num();
+			FNavSearchContext& Context = bForward ? Forward : Backward;
+			FNavSearchContext& Other = bForward ? Backward : Forward;
+			const FGridGraph& Graph = bForward ? ForwardGraph : BackwardGraph;
+			const FGridGraph& OtherGraph = bForward ? BackwardGraph : ForwardGraph;
+
+			const int32 CurrentNode = Context.OpenSet.Pop();
+			if (Other.IsClosed(CurrentNode))
+			{
+				continue;
+			}
+
+			FNavSearchNode& CurrentState = Context.Touch(CurrentNode);
+			CurrentState.bClosed = true;
+
+			// Pruning: no path through this cell can beat the best one found
+			const float CurrentGScore = CurrentState.GScore;
+			if (CurrentGScore + Graph.GetHeuristic(CurrentNode) >= BestCost
+				|| CurrentGScore + Other.OpenSet.GetMinKey() - OtherGraph.GetHeuristic(CurrentNode) >= BestCost)
+			{
+				continue;
+			}
+
+			++Context.NumExpanded;
+			if (Query.CancelFlag && (Context.NumExpanded % CancelPollInterval) == 0
+				&& Query.CancelFlag->load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			Grid.ForEachNeighbour(CurrentNode, [&](int32 Neighbour, float EdgeCost)
+				{
+					if (Context.IsClosed(Neighbour) || Other.IsClosed(Neighbour))
+					{
+						return;
+					}
+
+					const float TentativeG = CurrentGScore + EdgeCost;
+					if (TentativeG >= Context.GetGScore(Neighbour))
+					{
+						return;
+					}
+
+					// Forward moves enter the neighbour; backward moves leave it toward the current cell,
+					// so the start, where the agent already stands, is exempt like in plain A*
+					if (!(!bForward && Neighbour == StartNode)
+						&& (!Grid.IsPassable(Neighbour, Query.RequiredClearance) || !CellFilter(Neighbour)))
+					{
+						return;
+					}
+
+					FNavSearchNode& NeighbourState = Context.Touch(Neighbour);
+					NeighbourState.Parent = CurrentNode;
+					NeighbourState.GScore = TentativeG;
+					Context.OpenSet.PushOrDecrease(Neighbour, TentativeG + Graph.GetHeuristic(Neighbour));
+
+					// Reached by both directions: a complete path
+					const float OtherGScore = Other.GetGScore(Neighbour);
+					if (OtherGScore != MAX_flt && TentativeG + OtherGScore < BestCost)
+					{
+						BestCost = TentativeG + OtherGScore;
+						MeetingNode = Neighbour;
+					}
+				});
+		}
+
+		if (MeetingNode == INDEX_NONE)
+		{
+			return false;
+		}
+
+		// Start .. meeting cell from the forward parents, then on to the goal along the backward parents
+		Forward.BuildPath(MeetingNode);
+		for (int32 Node = Backward.GetParent(MeetingNode); Node != INDEX_NONE; Node = Backward.GetParent(Node))
+		{
+			Forward.PathNodes.Add(Node);
+		}
+
+		if (Query.bSmoothPath)
+		{
+			SmoothPath(Grid, Forward.PathNodes, Query.RequiredClearance, CellFilter);
+		}
+		return true;
+	}
+
+	/**
+	 * Lazy Theta* over the grid. Like A*, except that a cell is queued with the parent of the cell it was
+	 * reached from (straight-line cost), assuming line of sight; the assumption is checked once, when the
+	 * cell is expanded, and on failure the cell falls back to its best expanded neighbour.
+	 * Paths are any-angle (much shorter than 26-direction staircases) and near optimal.
+	 * On success the waypoints (start first) are left in Context.PathNodes.
+	 */
+	template <typename CellFilterType = FAcceptAllCells>
+	static bool FindAnyAnglePath(
+		const FNavGrid& Grid,
+		FNavSearchContext& Context,
+		const FNavPathQuery& Query,
+		CellFilterType&& CellFilter = CellFilterType())
+	{
+		const FGridGraph Graph(Grid, Query.RequiredClearance, Query.GoalNode);
+		Context.BeginSearch(Graph.GetNumNodes(), Graph.GetPagedSize());
+
+		FNavOpenSet& OpenSet = Context.OpenSet;
+		Context.Touch(Query.StartNode).GScore = 0.0f;
+		OpenSet.Push(Query.StartNode, Graph.GetHeuristic(Query.StartNode));
+
+		while (!OpenSet.IsEmpty())
+		{
+			const int32 CurrentNode = OpenSet.Pop();
+
+			FNavSearchNode& CurrentState = Context.Touch(CurrentNode);
+			CurrentState.bClosed = true;
+			++Context.NumExpanded;
+
+			// Verify the parent assumed when the cell was queued. The cell was queued from an
+			// expanded neighbour, so the fallback always finds one.
+			if (CurrentState.Parent != INDEX_NONE
+				&& !HasLineOfSight(Grid, CurrentState.Parent, CurrentNode, Query.RequiredClearance, CellFilter))
+			{
+				CurrentState.GScore = MAX_flt;
+				Grid.ForEachNeighbour(CurrentNode, [&Context, &CurrentState](int32 Neighbour, float EdgeCost)
+					{
+						const float NeighbourG = Context.GetGScore(Neighbour) + EdgeCost;
+						if (Context.IsClosed(Neighbour) && NeighbourG < CurrentState.GScore)
+						{
+							CurrentState.GScore = NeighbourG;
+							CurrentState.Parent = Neighbour;
+						}
+					});
+			}
+
+			if (CurrentNode == Query.GoalNode)
+			{
+				Context.BuildPath(CurrentNode);
+				return true;
+			}
+
+			if (Query.CancelFlag && (Context.NumExpanded % CancelPollInterval) == 0
+				&& Query.CancelFlag->load(std::memory_order_relaxed))
+			{
+				return false;
+			}
+
+			// Neighbours are queued with the current cell's parent (straight line) when it has one
+			const float CurrentGScore = CurrentState.GScore;
+			const int32 Origin = CurrentState.Parent != INDEX_NONE ? CurrentState.Parent : CurrentNode;
+			const float OriginGScore = Context.GetGScore(Origin);
+			const FVector OriginCoordinates(Grid.GetCoordinates(Origin));
+
+			Graph.ForEachNeighbour(CurrentNode, [&](int32 Neighbour, float EdgeCost)
+				{
+					if (Context.IsClosed(Neighbour))
+					{
+						return;
+					}
+
+					const float TentativeG = Origin != CurrentNode
+						? OriginGScore + static_cast<float>(FVector::Distance(OriginCoordinates, FVector(Grid.GetCoordinates(Neighbour))))
+						: CurrentGScore + EdgeCost;
+
+					if (TentativeG < Context.GetGScore(Neighbour))
+					{
+						if (!CellFilter(Neighbour))
+						{
+							return;
+						}
+
+						FNavSearchNode& NeighbourState = Context.Touch(Neighbour);
+						NeighbourState.Parent = Origin;
+						NeighbourState.GScore = TentativeG;
+						OpenSet.PushOrDecrease(Neighbour, TentativeG + Graph.GetHeuristic(Neighbour));
+					}
+				});
+		}
+
+		return false;
+	}
+
+	/**
+	 * Tests whether the straight segment between two cell centers stays in cells the agent fits in,
+	 * by walking every cell the segment crosses (3D DDA). Crossings are compared with integer
+	 * arithmetic, so a segment through a cell edge or corner is detected exactly; the cells touching
+	 * it must be clear as well. The start cell itself is not tested.
+	 *
+	 * @param Grid               Grid to test against.
+	 * @param FromNode           Linear index of the first cell.
+	 * @param ToNode             Linear index of the last cell.
+	 * @param RequiredClearance  Clearance every crossed cell must have.
+	 * @param CellFilter         Callable bool(int32 Cell) returning false to reject a cell.
+	 */
+	template <typename CellFilterType = FAcceptAllCells>
+	static bool HasLineOfSight(
+		const FNavGrid& Grid,
+		int32 FromNode,
+		int32 ToNode,
+		int32 RequiredClearance,
+		CellFilterType&& CellFilter = CellFilterType())
+	{
+		const FIntVector From = Grid.GetCoordinates(FromNode);
+		const FIntVector To = Grid.GetCoordinates(ToNode);
+		const FIntVector Step(FMath::Sign(To.X - From.X), FMath::Sign(To.Y - From.Y), FMath::Sign(To.Z - From.Z));
+		const int64 Length[3] = { FMath::Abs(To.X - From.X), FMath::Abs(To.Y - From.Y), FMath::Abs(To.Z - From.Z) };
+		int64 Crossed[3] = { 0, 0, 0 };
+
+		auto IsClear = [&Grid, RequiredClearance, &CellFilter](const FIntVector& Cell)
+			{
+				const int32 Index = Grid.GetIndex(Cell);
+				return Grid.IsPassable(Index, RequiredClearance) && CellFilter(Index);
+			};
+
+		FIntVector Cell = From;
+		while (Cell != To)
+		{
+			// The next boundary along an axis is crossed at t = (2 * Crossed + 1) / (2 * Length):
+			// find the earliest one(s) by cross-multiplying
+			int32 First = INDEX_NONE;
+			int32 TiedMask = 0;
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (Crossed[Axis] >= Length[Axis])
+				{
+					continue;
+				}
+
+				if (First != INDEX_NONE)
+				{
+					const int64 Lhs = (2 * Crossed[Axis] + 1) * Length[First];
+					const int64 Rhs = (2 * Crossed[First] + 1) * Length[Axis];
+					if (Lhs > Rhs)
+					{
+						continue;
+					}
+					if (Lhs == Rhs)
+					{
+						TiedMask |= 1 << Axis;
+						continue;
+					}
+				}
+				First = Axis;
+				TiedMask = 1 << Axis;
+			}
+
+			// Through an edge or corner: the cells sharing it are touched too
+			if ((TiedMask & (TiedMask - 1)) != 0)
+			{
+				for (int32 SubMask = (TiedMask - 1) & TiedMask; SubMask > 0; SubMask = (SubMask - 1) & TiedMask)
+				{
+					const FIntVector Side(
+						Cell.X + ((SubMask & 1) ? Step.X : 0),
+						Cell.Y + ((SubMask & 2) ? Step.Y : 0),
+						Cell.Z + ((SubMask & 4) ? Step.Z : 0));
+					if (!IsClear(Side))
+					{
+						return false;
+					}
+				}
+			}
+
+			for (int32 Axis = 0; Axis < 3; ++Axis)
+			{
+				if (TiedMask & (1 << Axis))
+				{
+					Cell[Axis] += Step[Axis];
+					++Crossed[Axis];
+				}
+			}
+
+			if (!IsClear(Cell))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Removes waypoints from a cell path (start first) in place, keeping start and goal.
+	 * Cells continuing a straight run are dropped first; then each remaining waypoint is skipped
+	 * while the last kept waypoint still has line of sight past it (string pulling).
+	 * The result only contains segments that pass HasLineOfSight or were segments of the input.
+	 */
+	template <typename CellFilterType = FAcceptAllCells>
+	static void SmoothPath(
+		const FNavGrid& Grid,
+		TArray<int32>& PathNodes,
+		int32 RequiredClearance,
+		CellFilterType&& CellFilter = CellFilterType())
+	{
+		if (PathNodes.Num() < 3)
+		{
+			return;
+		}
+
+		// Pass 1: keep only the cells where the step changes
+		int32 Write = 1;
+		FIntVector Previous = Grid.GetCoordinates(PathNodes[0]);
+		FIntVector Current = Grid.GetCoordinates(PathNodes[1]);
+		for (int32 Read = 1; Read < PathNodes.Num() - 1; ++Read)
+		{
+			const FIntVector Next = Grid.GetCoordinates(PathNodes[Read + 1]);
+			if (Current - Previous != Next - Current)
+			{
+				PathNodes[Write++] = PathNodes[Read];
+			}
+			Previous = Current;
+			Current = Next;
+		}
+		PathNodes[Write++] = PathNodes.Last();
+		PathNodes.SetNum(Write, EAllowShrinking::No);
+
+		// Pass 2: string pulling over the turning points
+		Write = 1;
+		int32 Anchor = PathNodes[0];
+		for (int32 Read = 2; Read < PathNodes.Num(); ++Read)
+		{
+			if (!HasLineOfSight(Grid, Anchor, PathNodes[Read], RequiredClearance, CellFilter))
+			{
+				Anchor = PathNodes[Read - 1];
+				PathNodes[Write++] = Anchor;
+			}
+		}
+		PathNodes[Write++] = PathNodes.Last();
+		PathNodes.SetNum(Write, EAllowShrinking::No);
+	}
+
+	/** Returns true if jump point search applies to the grid (26-connected, MinSharedNeighborAxes = 0). */
+	static FORCEINLINE bool SupportsJumpPoints(const FNavGrid& Grid)
+	{
+		return Grid.GetNeighbourOffsets().Num() == 26;
+	}
+
+	/**
+	 * Finds the cell nearest to InFromNode (straight-line distance in cells) that passes the clearance
+	 * test and the optional filters, within MaxRadius cells on every axis.
+	 * Cells are scanned in cubic shells of growing radius straight from the blocked bits and clearance
+	 * field; shells do not overlap, so there is no queue and no visited set. A candidate is accepted
+	 * once no unscanned cell can be closer.
+	 *
+	 * @param CellFilter     Cheap test run on every passable cell in range (e.g. dynamic occupancy).
+	 * @param MaxRadius      Search bound in cells (Chebyshev distance); farther cells are never considered.
+	 * @param ConfirmFilter  Expensive test (e.g. a physics overlap) run only on accepted candidates, nearest
+	 *                       first, until one passes; usually that is the first one.
+	 *
+	 * @return Linear index of the nearest free cell, or INDEX_NONE if none found.
+	 */
+	template <typename CellFilterType = FAcceptAllCells, typename ConfirmFilterType = FAcceptAllCells>
+	static int32 FindNearestFreeNode(
+		const FNavGrid& Grid,
+		int32 InFromNode,
+		int32 RequiredClearance,
+		CellFilterType&& CellFilter = CellFilterType(),
+		int32 MaxRadius = FNavPathQuery::DefaultGoalSearchRadius,
+		ConfirmFilterType&& ConfirmFilter = ConfirmFilterType())
+	{
+		if (InFromNode < 0 || InFromNode >= Grid.GetNumCells())
+		{
+			return INDEX_NONE;
+		}
+
+		const FIntVector From = Grid.GetCoordinates(InFromNode);
+		const FIntVector Size = Grid.GetSize();
+		const int32 Radius = FMath::Min(FMath::Max(MaxRadius, 0), FMath::Max3(Size.X, Size.Y, Size.Z) - 1);
+
+		// Cells that passed the cheap tests, by squared distance then index; consumed from the front
+		struct FCandidate
+		{
+			int32 DistanceSquared;
+			int32 Cell;
+
+			FORCEINLINE bool operator<(const FCandidate& Other) const
+			{
+				return DistanceSquared != Other.DistanceSquared ? DistanceSquared < Other.DistanceSquared : Cell < Other.Cell;
+			}
+		};
+		TArray<FCandidate, TInlineAllocator<64>> Candidates;
+
+		// Confirms candidates strictly closer than Bound, nearest first
+		auto TryCandidates = [&Candidates, &ConfirmFilter](int32 BoundSquared)
+			{
+				int32 NumTried = 0;
+				int32 Found = INDEX_NONE;
+				while (NumTried < Candidates.Num() && Candidates[NumTried].DistanceSquared < BoundSquared)
+				{
+					const int32 Cell = Candidates[NumTried++].Cell;
+					if (ConfirmFilter(Cell))
+					{
+						Found = Cell;
+						break;
+					}
+				}
+				Candidates.RemoveAt(0, NumTried, EAllowShrinking::No);
+				return Found;
+			};
+
+		auto TestCell = [&Grid, &Candidates, &CellFilter, &From, RequiredClearance](int32 X, int32 Y, int32 Z)
+			{
+				const int32 Cell = Grid.GetIndex(FIntVector(X, Y, Z));
+				if (Grid.IsPassable(Cell, RequiredClearance) && CellFilter(Cell))
+				{
+					const int32 DX = X - From.X;
+					const int32 DY = Y - From.Y;
+					const int32 DZ = Z - From.Z;
+					Candidates.Add({ DX * DX + DY * DY + DZ * DZ, Cell });
+				}
+			};
+
+		for (int32 Shell = 0; Shell <= Radius; ++Shell)
+		{
+			const int32 MinZ = FMath::Max(From.Z - Shell, 0);
+			const int32 MaxZ = FMath::Min(From.Z + Shell, Size.Z - 1);
+			const int32 MinY = FMath::Max(From.Y - Shell, 0);
+			const int32 MaxY = FMath::Min(From.Y + Shell, Size.Y - 1);
+			const int32 MinX = FMath::Max(From.X - Shell, 0);
+			const int32 MaxX = FMath::Min(From.X + Shell, Size.X - 1);
+
+			const int32 NumCandidates = Candidates.Num();
+			for (int32 Z = MinZ; Z <= MaxZ; ++Z)
+			{
+				const bool bZFace = FMath::Abs(Z - From.Z) == Shell;
+				for (int32 Y = MinY; Y <= MaxY; ++Y)
+				{
+					if (bZFace || FMath::Abs(Y - From.Y) == Shell)
+					{
+						// On a face of the shell: the whole row
+						for (int32 X = MinX; X <= MaxX; ++X)
+						{
+							TestCell(X, Y, Z);
+						}
+					}
+					else
+					{
+						// Inside the shell: only its two X faces
+						if (From.X - Shell >= 0)
+						{
+							TestCell(From.X - Shell, Y, Z);
+						}
+						if (Shell > 0 && From.X + Shell < Size.X)
+						{
+							TestCell(From.X + Shell, Y, Z);
+						}
+					}
+				}
+			}
+
+			if (Candidates.Num() > NumCandidates)
+			{
+				Candidates.Sort();
+			}
+
+			// Every unscanned cell is at least Shell + 1 away
+			const int32 Found = TryCandidates((Shell + 1) * (Shell + 1));
+			if (Found != INDEX_NONE)
+			{
+				return Found;
+			}
+		}
+
+		// Cells beyond the bound are not considered, so the remaining candidates are final
+		return TryCandidates(MAX_int32);
+	}
+};
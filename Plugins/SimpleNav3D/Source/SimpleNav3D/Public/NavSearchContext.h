@@ -0,0 +1,129 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavOpenSet.h"
+#include "Algo/Reverse.h"
+
+/**
+ * Per-node scratch state used by A*.
+ * Only meaningful when Generation matches the owning context's current generation.
+ */
+struct FNavSearchNode
+{
+	/** Cost of the best known path from the start node. */
+	float GScore = MAX_flt;
+
+	/** Linear index of the node we came from (INDEX_NONE for the start node). */
+	int32 Parent = INDEX_NONE;
+
+	/** Query generation that last touched this entry. */
+	uint32 Generation = 0;
+
+	/** Whether the node has already been expanded in the current query. */
+	bool bClosed = false;
+};
+
+/**
+ * FNavSearchContext
+ *
+ * Reusable scratch memory for A* over the linear cell index space (see AOctNavVolume3D::GetNode).
+ * - Node state lives in an array indexed by cell index instead of hash maps keyed by pointers. It is
+ *   flat, or paged by brick for brick-storage grids, where per-cell state for the whole bounding box
+ *   would dwarf the grid itself (see TNavNodeArray).
+ * - The open set is an indexed heap with decrease-key (see FNavOpenSet).
+ * - A generation stamp marks the entries that belong to the current query,
+ *   so nothing has to be cleared between searches.
+ * - Arrays only grow; after warm-up a query performs no heap allocations.
+ */
+struct FNavSearchContext
+{
+public:
+	/**
+	 * Prepares the context for a new query over NumNodes nodes.
+	 * Grows the node array if needed and invalidates all previous state in O(1).
+	 *
+	 * @param PagedSize  Grid size to page the node state by (FNavGrid::GetSearchPagedSize), or zero for flat storage.
+	 */
+	void BeginSearch(int32 NumNodes, const FIntVector& PagedSize = FIntVector::ZeroValue)
+	{
+		Nodes.Reset(NumNodes, PagedSize);
+		OpenSet.Reset(NumNodes, PagedSize);
+		NumExpanded = 0;
+
+		++Generation;
+		if (Generation == 0)
+		{
+			// Generation counter wrapped around: stale stamps could alias, so clear them once.
+			Nodes.ForEachElement([](FNavSearchNode& Node)
+				{
+					Node.Generation = 0;
+				});
+			Generation = 1;
+		}
+	}
+
+	/** Returns the node state for the current query, resetting it on first access. */
+	FORCEINLINE FNavSearchNode& Touch(int32 Index)
+	{
+		FNavSearchNode& Node = Nodes[Index];
+		if (Node.Generation != Generation)
+		{
+			Node.GScore = MAX_flt;
+			Node.Parent = INDEX_NONE;
+			Node.bClosed = false;
+			Node.Generation = Generation;
+		}
+		return Node;
+	}
+
+	/** Returns the best known g-score for a node ("infinite" if not reached yet). */
+	FORCEINLINE float GetGScore(int32 Index) const
+	{
+		const FNavSearchNode& Node = Nodes[Index];
+		return (Node.Generation == Generation) ? Node.GScore : MAX_flt;
+	}
+
+	/** Returns the parent of a node, or INDEX_NONE if it has none in the current query. */
+	FORCEINLINE int32 GetParent(int32 Index) const
+	{
+		const FNavSearchNode& Node = Nodes[Index];
+		return (Node.Generation == Generation) ? Node.Parent : INDEX_NONE;
+	}
+
+	/** Returns true if the node was already expanded in the current query. */
+	FORCEINLINE bool IsClosed(int32 Index) const
+	{
+		const FNavSearchNode& Node = Nodes[Index];
+		return Node.Generation == Generation && Node.bClosed;
+	}
+
+	/**
+	 * Reconstructs the path ending at GoalIndex into PathNodes (start first).
+	 * Walks the parent chain appending, then reverses in place: O(n), no reallocation once warm.
+	 */
+	void BuildPath(int32 GoalIndex)
+	{
+		PathNodes.Reset();
+		for (int32 Node = GoalIndex; Node != INDEX_NONE; Node = GetParent(Node))
+		{
+			PathNodes.Add(Node);
+		}
+		Algo::Reverse(PathNodes);
+	}
+
+	/** Open set keyed on FScore; each node appears at most once. */
+	FNavOpenSet OpenSet;
+
+	/** Number of nodes expanded (popped and closed) in the current query. */
+	int32 NumExpanded = 0;
+
+	/** Node indices of the last reconstructed path, start first. */
+	TArray<int32> PathNodes;
+
+private:
+	/** Per-node state, indexed by linear cell index. */
+	TNavNodeArray<FNavSearchNode> Nodes;
+
+	/** Current query generation. 0 is reserved for "never touched". */
+	uint32 Generation = 0;
+};
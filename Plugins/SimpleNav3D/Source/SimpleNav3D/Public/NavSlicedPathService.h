@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Deque.h"
+#include "Containers/Queue.h"
+#include "NavAsyncPathService.h"
+#include "NavOccupancyLayer.h"
+#include "NavPathfinder.h"
+#include "NavSearchContext.h"
+
+/**
+ * FNavSlicedPathService
+ *
+ * Runs path requests on the game thread in time slices, for callers that cannot go async.
+ * - Each active search keeps its open set and node states in its own FNavSearchContext (pooled), so it
+ *   resumes where it stopped on the next tick.
+ * - Tick shares one budget (milliseconds and/or expansions) among all active searches round-robin,
+ *   a small slice each, so no search starves and the total game-thread cost is capped regardless of
+ *   how many agents request paths.
+ * - At most MaxConcurrentSearches searches hold a context; further requests wait in FIFO order.
+ * - A search runs on the grid snapshot it started with; region rebuilds published meanwhile apply to later requests.
+ * - Searches avoid the dynamic obstacle layer as it is on every tick. Jump point search is used when
+ *   requested and no obstacle covers cells at the start; any-angle requests run A* followed by smoothing.
+ *
+ * All functions must be called from the game thread.
+ */
+class SIMPLENAV3D_API FNavSlicedPathService
+{
+public:
+	/** Expansions an active search runs before the next one gets its turn. */
+	static constexpr int32 SliceExpansions = 64;
+
+	/**
+	 * Queues a path request. It becomes active in a Tick with a free slot.
+	 *
+	 * @param InStart             World-space start location.
+	 * @param InDestination       World-space goal location (relocated to the nearest free cell if needed).
+	 * @param Options             Clearance and search variant; start and goal are filled in when the search starts.
+	 * @param IgnoredObstacleSlot Dynamic obstacle slot of the requesting agent itself, or INDEX_NONE.
+	 *
+	 * @return Id identifying the request in results and CancelRequest.
+	 */
+	int32 AddRequest(const FVector& InStart, const FVector& InDestination, const FNavPathQuery& Options, int32 IgnoredObstacleSlot = INDEX_NONE);
+
+	/**
+	 * Cancels a queued or active request. It produces no result.
+	 *
+	 * @return true if the request was still outstanding.
+	 */
+	bool CancelRequest(int32 RequestId);
+
+	/**
+	 * Advances active searches until the budget is used up. Finished searches post their result and
+	 * free their slot for the next queued request within the same tick.
+	 *
+	 * @param Snapshot               Grid that newly started searches run on.
+	 * @param Occupancy              Current dynamic obstacles (may be null).
+	 * @param BudgetSeconds          Time budget of this tick; 0 for none.
+	 * @param MaxExpansions          Expansion budget of this tick; 0 for none.
+	 * @param MaxConcurrentSearches  Upper bound on searches holding a context.
+	 */
+	void Tick(const FNavGridSnapshotPtr& Snapshot, const FNavOccupancyLayer* Occupancy, double BudgetSeconds, int32 MaxExpansions, int32 MaxConcurrentSearches);
+
+	/** Retrieves the next finished result. Returns false if none is ready. */
+	bool PopResult(FNavAsyncPathResult& OutResult);
+
+	/** Drops all requests, results and pooled contexts. */
+	void Reset();
+
+	/** Returns the number of queued and active requests. */
+	FORCEINLINE int32 GetNumOutstanding() const { return NumQueued + Active.Num(); }
+
+	/** Returns the number of nodes expanded by the last Tick (for profiling). */
+	FORCEINLINE int32 GetNumExpandedLastTick() const { return NumExpandedLastTick; }
+
+private:
+	/** A queued or active request. */
+	struct FRequest
+	{
+		int32 RequestId = INDEX_NONE;
+		FVector Start = FVector::ZeroVector;
+		FVector Destination = FVector::ZeroVector;
+		FNavPathQuery Options;
+		int32 IgnoredObstacleSlot = INDEX_NONE;
+
+		/** Set once active: the grid searched, the search state and whether it runs over jump points. */
+		FNavGridSnapshotPtr Grid;
+		TUniquePtr<FNavSearchContext> Context;
+		bool bJumpPoints = false;
+	};
+
+	/**
+	 * Resolves the cells of a request, relocates its goal and starts its search.
+	 *
+	 * @return false if the request already failed (no free goal); its result has been posted.
+	 */
+	bool StartRequest(FRequest& Request, const FNavGridSnapshotPtr& Snapshot, const FNavOccupancyLayer* Occupancy);
+
+	/** Runs one slice of an active search. */
+	ENavSearchStatus StepRequest(FRequest& Request, const FNavOccupancyLayer* Occupancy, int32 MaxExpansions);
+
+	/** Posts the result of a finished search (path on success) and returns its context to the pool. */
+	void FinishRequest(FRequest& Request, bool bSuccess, const FNavOccupancyLayer* Occupancy);
+
+	/** Waiting requests, oldest first. Cancelled ones stay as entries with RequestId INDEX_NONE until popped. */
+	TDeque<FRequest> Queued;
+	int32 NumQueued = 0;
+
+	/** Searches holding a context, in round-robin order. */
+	TArray<FRequest> Active;
+
+	/** Active search that gets the next slice. */
+	int32 NextActive = 0;
+
+	/** Contexts not held by an active search. */
+	TArray<TUniquePtr<FNavSearchContext>> FreeContexts;
+
+	/** Finished results waiting for PopResult. */
+	TQueue<FNavAsyncPathResult> Results;
+
+	int32 NextRequestId = 1;
+	int32 NumExpandedLastTick = 0;
+};
@@ -0,0 +1,153 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NavOctree.h"
+
+/**
+ * A face-adjacency link between two free octree leaves.
+ */
+struct FNavSparseVoxelLink
+{
+	/** Graph node on the other side of the shared face. */
+	int32 Node = INDEX_NONE;
+
+	/** Distance between the two leaf centers. */
+	float Cost = 0.0f;
+
+	/** Smaller side of the shared face rectangle (largest agent diameter that fits through). */
+	float PortalSize = 0.0f;
+
+	/** Center of the shared face rectangle. */
+	FVector Portal = FVector::ZeroVector;
+
+	friend FArchive& operator<<(FArchive& Ar, FNavSparseVoxelLink& Link)
+	{
+		return Ar << Link.Node << Link.Cost << Link.PortalSize << Link.Portal;
+	}
+};
+
+/**
+ * FNavSparseVoxelGraph
+ *
+ * Navigation graph over the free leaves of an FNavOctree (sparse voxel octree navigation).
+ * - One node per free leaf, of any size, so open space is crossed in a few large steps.
+ * - Links connect leaves sharing part of a face, across octree levels, and are stored in
+ *   compressed sparse row form (per-node offset into one link array).
+ * - Paths are returned as leaf indices; world-space points go through the portal (shared face)
+ *   centers between consecutive leaves.
+ */
+struct SIMPLENAV3D_API FNavSparseVoxelGraph
+{
+public:
+	/** Builds nodes and links from a classified (and optionally collapsed) octree. */
+	void Build(const FNavOctree& Octree);
+
+	/** Releases all storage. */
+	void Reset();
+
+	/**
+	 * Saves or loads the nodes and links. The graph stays tied to the octree it was built from.
+	 * A load with inconsistent link offsets or node indices flags the archive as failed and resets the graph.
+	 */
+	void Serialize(FArchive& Ar);
+
+	/** Returns true if the graph has at least one node. */
+	FORCEINLINE bool IsBuilt() const { return Bounds.Num() > 0; }
+
+	/** Returns true if the graph's leaf lookup matches the arena of this octree (the tree it was built from). */
+	FORCEINLINE bool IsBuiltFor(const FNavOctree& Octree) const { return OctreeNodeToGraphNode.Num() == Octree.GetNumNodes(); }
+
+	/** Returns the number of graph nodes (free leaves). */
+	FORCEINLINE int32 GetNumNodes() const { return Bounds.Num(); }
+
+	/** Returns the total number of directed links. */
+	FORCEINLINE int32 GetNumLinks() const { return Links.Num(); }
+
+	/** Returns the world-space bounds of a node's leaf. */
+	FORCEINLINE const FBox& GetBounds(int32 Node) const { return Bounds[Node]; }
+
+	/** Returns the world-space center of a node's leaf. */
+	FORCEINLINE FVector GetCenter(int32 Node) const { return Bounds[Node].GetCenter(); }
+
+	/** Returns the links leaving a node. */
+	FORCEINLINE TArrayView<const FNavSparseVoxelLink> GetLinks(int32 Node) const
+	{
+		return TArrayView<const FNavSparseVoxelLink>(Links.GetData() + FirstLink[Node], FirstLink[Node + 1] - FirstLink[Node]);
+	}
+
+	/** Returns the link from one node to another, or nullptr if they are not adjacent. */
+	const FNavSparseVoxelLink* FindLink(int32 FromNode, int32 ToNode) const;
+
+	/** Returns the graph node of the free leaf containing a point, or INDEX_NONE (outside or blocked). */
+	int32 FindNode(const FNavOctree& Octree, const FVector& WorldPoint) const;
+
+	/**
+	 * Converts a node path (start first) to world-space points: InStart, the portal centers
+	 * between consecutive leaves, then InEnd.
+	 */
+	template <typename AllocatorType>
+	void BuildPathPoints(const TArray<int32>& PathNodes, const FVector& InStart, const FVector& InEnd, TArray<FVector, AllocatorType>& OutPath) const
+	{
+		OutPath.Reserve(OutPath.Num() + PathNodes.Num() + 1);
+		OutPath.Add(InStart);
+		for (int32 Index = 1; Index < PathNodes.Num(); ++Index)
+		{
+			const FNavSparseVoxelLink* Link = FindLink(PathNodes[Index - 1], PathNodes[Index]);
+			OutPath.Add(Link ? Link->Portal : GetCenter(PathNodes[Index]));
+		}
+		OutPath.Add(InEnd);
+	}
+
+	/**
+	 * The graph as an A* graph for one query (see FNavPathfinder::FindGraphPath):
+	 * links narrower than the agent are skipped, the heuristic is the straight-line distance
+	 * between leaf centers.
+	 */
+	struct FSearchGraph
+	{
+		FSearchGraph(const FNavSparseVoxelGraph& InGraph, int32 InGoalNode, float InMinPortalSize)
+			: Graph(InGraph)
+			, GoalCenter(InGraph.GetCenter(InGoalNode))
+			, MinPortalSize(InMinPortalSize)
+		{
+		}
+
+		FORCEINLINE int32 GetNumNodes() const { return Graph.GetNumNodes(); }
+
+		FORCEINLINE FIntVector GetPagedSize() const { return FIntVector::ZeroValue; }
+
+		FORCEINLINE float GetHeuristic(int32 Node) const
+		{
+			return FVector::Distance(Graph.GetCenter(Node), GoalCenter);
+		}
+
+		template <typename FuncType>
+		FORCEINLINE void ForEachNeighbour(int32 Node, FuncType&& Func) const
+		{
+			for (const FNavSparseVoxelLink& Link : Graph.GetLinks(Node))
+			{
+				if (Link.PortalSize >= MinPortalSize)
+				{
+					Func(Link.Node, Link.Cost);
+				}
+			}
+		}
+
+		const FNavSparseVoxelGraph& Graph;
+		FVector GoalCenter;
+		float MinPortalSize;
+	};
+
+private:
+	/** Leaf bounds per graph node. */
+	TArray<FBox> Bounds;
+
+	/** Links of node N are Links[FirstLink[N] .. FirstLink[N + 1]). Has GetNumNodes() + 1 entries. */
+	TArray<int32> FirstLink;
+
+	/** All links, grouped by source node. */
+	TArray<FNavSparseVoxelLink> Links;
+
+	/** Graph node per octree arena index (INDEX_NONE for inner nodes and blocked leaves). */
+	TArray<int32> OctreeNodeToGraphNode;
+};
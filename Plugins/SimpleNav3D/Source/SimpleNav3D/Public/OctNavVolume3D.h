@@ -2,45 +2,127 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "CollisionQueryParams.h"
+#include "CollisionShape.h"
+#include "NavGrid.h"
+#include "NavOctree.h"
+#include "NavSparseVoxelGraph.h"
+#include "NavClusterGraph.h"
+#include "NavComponentLabels.h"
+#include "NavOccupancyLayer.h"
+#include "NavSearchContext.h"
+#include "NavPathTypes.h"
+#include "NavAsyncPathService.h"
+#include "NavSlicedPathService.h"
+#include "NavBatchPathService.h"
+#include "NavPathCache.h"
+#include "NavFlowField.h"
+#include "NavIncrementalPlanner.h"
+#include "Tasks/Task.h"
 #include "OctNavVolume3D.generated.h"
 
 class UProceduralMeshComponent;
-class NavNode;
+class UPrimitiveComponent;
+class UNavBakedData;
+struct FNavBakeSettings;
 
 /**
- * Lightweight octree node used for coarse 3D occupancy / blockage queries.
- * Each node stores a bounding box, leaf flag, blocked flag, and up to 8 children.
+ * Capsule overlap query built once per path query.
+ * Keeps the object/query params and shape alive across all cells tested by that query,
+ * instead of rebuilding them for every neighbour.
  */
-struct FOctreeNode
+struct FNavOverlapQuery
 {
-	/** Axis-aligned bounds represented by this node in world space. */
-	FBox Bounds;
+	/** Object types treated as obstacles. */
+	FCollisionObjectQueryParams ObjectParams;
 
-	/** Whether this node is a leaf in the octree. */
-	bool bIsLeaf = true;
+	/** Query params (ignored actor, initial overlaps). */
+	FCollisionQueryParams QueryParams;
 
-	/** Whether this node's region is considered blocked (e.g., overlaps geometry). */
-	bool bBlocked = false;
+	/** Agent capsule. */
+	FCollisionShape Shape;
 
-	/** Child pointers for the 8 octants (nullptr if not present / leaf). */
-	FOctreeNode* Children[8] = { nullptr };
+	FNavOverlapQuery(
+		float InAgentRadius,
+		float InAgentHalfHeight,
+		AActor* IgnoreActor,
+		const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes);
+};
 
-	FOctreeNode(const FBox& InBounds)
-		: Bounds(InBounds)
-	{
-	}
+/**
+ * One background rebuild of dirty regions.
+ * The worker re-evaluates private copies of the octree and grid; the game thread swaps them in
+ * once the task has finished, so queries never see a half-updated state.
+ */
+struct FNavRegionRebuild
+{
+	/** World-space boxes to re-evaluate, already clipped to the volume. */
+	TArray<FBox> Regions;
 
-	~FOctreeNode()
-	{
-		for (int i = 0; i < 8; ++i)
-		{
-			if (Children[i])
-			{
-				delete Children[i];
-				Children[i] = nullptr;
-			}
-		}
-	}
+	/** Copy of the octree, refined and re-classified inside the regions. */
+	FNavOctree Octree;
+
+	/** Copy of the grid with the blocked bits and clearance of the regions rewritten. */
+	TSharedPtr<FNavGrid, ESPMode::ThreadSafe> Grid;
+
+	/** Whether the sparse voxel graph is rebuilt from the new octree as well. */
+	bool bBuildSparseVoxelGraph = false;
+
+	/** Rebuilt sparse voxel graph (if requested). */
+	FNavSparseVoxelGraph SparseVoxelGraph;
+
+	/** Inclusive cell ranges whose blocked bits were rewritten, one per region. */
+	TArray<TPair<FIntVector, FIntVector>> DirtyCellRanges;
+
+	/** Number of octree leaves re-tested. */
+	int32 NumLeavesTested = 0;
+
+	/** Clearances whose component labels are relabelled on the new grid, and the result. */
+	TArray<int32> ComponentLabelClearances;
+	TMap<int32, FNavComponentLabels> ComponentLabels;
+};
+
+/**
+ * A primitive whose bounds are watched for movement; see AOctNavVolume3D::RegisterDynamicPrimitive.
+ */
+struct FNavDynamicPrimitive
+{
+	TWeakObjectPtr<UPrimitiveComponent> Primitive;
+
+	/** Bounds at the last time the primitive dirtied the volume. */
+	FBox LastBounds = FBox(ForceInit);
+};
+
+/**
+ * A moving actor rasterized into the dynamic occupancy layer; see AOctNavVolume3D::RegisterDynamicObstacle.
+ */
+struct FNavDynamicObstacle
+{
+	TWeakObjectPtr<AActor> Actor;
+
+	/** Slot in the occupancy layer. */
+	int32 Slot = INDEX_NONE;
+
+	/** Cell range last written to the layer. */
+	bool bHasCells = false;
+	FIntVector MinCell = FIntVector::ZeroValue;
+	FIntVector MaxCell = FIntVector::ZeroValue;
+};
+
+/**
+ * A planner created with AOctNavVolume3D::CreateIncrementalPlanner and the agent it plans for.
+ */
+struct FNavIncrementalPlannerEntry
+{
+	/** Search tree kept between updates. */
+	FNavIncrementalPlanner Planner;
+
+	/** Agent capsule (clearance requirement), resolved on every update. */
+	float DetectionRadius = 34.f;
+	float DetectionHalfHeight = 44.f;
+
+	/** The agent itself; its own dynamic obstacle cells are not avoided. */
+	TWeakObjectPtr<AActor> Agent;
 };
 
 /**
@@ -62,10 +144,19 @@ enum class EPathPreference : uint8
 /**
  * 3D Navigation Volume
  *
- * - Builds a regular 3D grid of NavNodes in local space.
+ * - Builds a compact regular 3D grid (bit-packed walkability, implicit neighbours) in local space.
  * - Visualizes the grid with a procedural debug mesh.
- * - Builds an octree over the volume for coarse blockage queries.
- * - Provides A* pathfinding and nearest-free-node search in 3D.
+ * - Builds an octree over the volume and bakes it into a per-cell blocked bitfield.
+ * - Derives a per-cell clearance field so agent size is checked without physics queries.
+ * - Provides A* pathfinding and nearest-free-node search in 3D, synchronously, time-sliced on the game thread or on worker threads.
+ * - Runs batches of path queries in parallel, one search context per worker.
+ * - Optionally searches the free octree leaves instead of the grid cells (sparse voxel octree mode).
+ * - Re-evaluates dirty regions (changed level geometry) on a worker thread and swaps the result in.
+ * - Rasterizes registered moving obstacles into a per-tick occupancy layer shared by all queries.
+ * - Labels connected components of the free space, so queries toward sealed-off goals fail immediately.
+ * - Optionally caches grid paths, invalidated per region when geometry or obstacles change.
+ * - Builds a flow field toward a shared goal, so many agents step toward it without their own search.
+ * - Keeps per-agent incremental planners (D* Lite) that repair their search when the goal or obstacles move.
  *
  * Designed to be dropped into a level as an axis-aligned navigation volume.
  */
@@ -82,7 +173,7 @@ public:
 	/** Called when the actor is constructed or a property is changed in the editor. */
 	virtual void OnConstruction(const FTransform& Transform) override;
 
-	/** Per-frame update. Currently unused but available for future debug/visualization. */
+	/** Per-frame update. Dispatches async path requests and delivers their results. */
 	virtual void Tick(float DeltaTime) override;
 
 protected:
@@ -115,10 +206,11 @@ public:
 	FORCEINLINE int32 GetTotalDivisions() { return DivisionsX * DivisionsY * DivisionsZ; }
 
 	/**
-	 * Returns a pointer to the NavNode at the given grid coordinates (clamped to volume).
+	 * Returns the linear cell index at the given grid coordinates (clamped to volume),
+	 * or INDEX_NONE if the grid has not been built yet.
 	 * @param Coordinates  Integer grid coordinates (X, Y, Z).
 	 */
-	NavNode* GetNode(FIntVector Coordinates);
+	int32 GetNode(FIntVector Coordinates) const;
 
 	// --------------------------------------------------------------------
 	// World <-> Grid Conversion
@@ -155,8 +247,8 @@ public:
 	 * @param InActorClassFilter    Optional actor class filter (can be nullptr).
 	 * @param OutPath               Output array of world-space points forming the path.
 	 * @param InActor               Optional actor to ignore and/or use for agent size.
-	 * @param InDetectionRadius     Agent capsule radius used for overlap checks.
-	 * @param InDetectionHalfHeight Agent capsule half-height used for overlap checks.
+	 * @param InDetectionRadius     Agent capsule radius (clearance requirement and optional overlap checks).
+	 * @param InDetectionHalfHeight Agent capsule half-height (clearance requirement and optional overlap checks).
 	 *
 	 * @return true if a valid path was found, false otherwise.
 	 */
@@ -172,7 +264,387 @@ public:
 		float InDetectionHalfHeight = 44.f
 	);
 
+	/**
+	 * Allocation-free variant of FindPath for C++ callers.
+	 * Writes into a caller-owned array, e.g. TArray<FVector, TInlineAllocator<64>>, which keeps
+	 * its capacity between calls so steady-state agents never reallocate their path.
+	 * Parameters and return value match FindPath above.
+	 */
+	template <typename AllocatorType>
+	bool FindPath(
+		const FVector& InStart,
+		const FVector& InDestination,
+		const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
+		UClass* InActorClassFilter,
+		TArray<FVector, AllocatorType>& OutPath,
+		AActor* InActor = nullptr,
+		float InDetectionRadius = 34.f,
+		float InDetectionHalfHeight = 44.f)
+	{
+		OutPath.Reset();
+		FVector GoalLocation;
+		if (!FindPathNodes(InStart, InDestination, InObjectTypes, InActorClassFilter, InActor, InDetectionRadius, InDetectionHalfHeight, GoalLocation))
+		{
+			return false;
+		}
+		CopyPathPoints(InStart, GoalLocation, OutPath);
+		return true;
+	}
+
+	/**
+	 * Returns true if an agent of the given size can get from one location to the other on the static
+	 * geometry (same connected component). Dynamic obstacles are not considered. Constant time once the
+	 * labels for the agent's size class exist; they are built on first call, whatever bUseComponentLabels
+	 * says, and cost an int32 per cell.
+	 *
+	 * @param InStart               World-space start location.
+	 * @param InDestination         World-space goal location (not relocated).
+	 * @param InDetectionRadius     Agent capsule radius (clearance requirement).
+	 * @param InDetectionHalfHeight Agent capsule half-height (clearance requirement).
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D")
+	bool AreLocationsConnected(const FVector& InStart, const FVector& InDestination, float InDetectionRadius = 34.f, float InDetectionHalfHeight = 44.f);
+
+	// --------------------------------------------------------------------
+	// Asynchronous Pathfinding
+	// --------------------------------------------------------------------
+
+	/**
+	 * Queues a path request that runs A* on a worker thread against a read-only snapshot of the grid.
+	 * OnComplete fires on the game thread from Tick; at most MaxAsyncResultsPerFrame callbacks run per frame.
+	 * Only the baked occupancy / clearance field is considered (no physics overlap checks).
+	 *
+	 * @param InStart               World-space start location.
+	 * @param InDestination         World-space goal location.
+	 * @param OnComplete            Called with the result; not called if the request is cancelled.
+	 * @param InPriority            Waiting requests are launched highest priority first.
+	 * @param InDetectionRadius     Agent capsule radius (clearance requirement).
+	 * @param InDetectionHalfHeight Agent capsule half-height (clearance requirement).
+	 * @param InActor               Optional requesting actor; if it is a registered dynamic obstacle, its own cells are ignored.
+	 *
+	 * @return Request id for CancelPathRequest, or INDEX_NONE if the grid is not built.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D")
+	int32 RequestPathAsync(
+		const FVector& InStart,
+		const FVector& InDestination,
+		const FOnNavPathRequestComplete& OnComplete,
+		EPathRequestPriority InPriority = EPathRequestPriority::EPRP_Normal,
+		float InDetectionRadius = 34.f,
+		float InDetectionHalfHeight = 44.f,
+		AActor* InActor = nullptr
+	);
+
+	/**
+	 * Cancels a pending async path request. Its callback will not fire.
+	 *
+	 * @return true if the request was still pending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D")
+	bool CancelPathRequest(int32 RequestId);
+
+	// --------------------------------------------------------------------
+	// Time-Sliced Pathfinding
+	// --------------------------------------------------------------------
+
+	/**
+	 * Queues a path request that runs on the game thread, resumed every tick until it finishes.
+	 * All sliced requests share one per-tick budget (SlicedSearchBudgetMs, SlicedSearchExpansionsPerTick)
+	 * round-robin, so their game-thread cost stays capped however many agents ask at once.
+	 * OnComplete fires from Tick. Searches avoid registered dynamic obstacles but run no physics overlaps.
+	 *
+	 * @param InStart               World-space start location.
+	 * @param InDestination         World-space goal location.
+	 * @param OnComplete            Called with the result; not called if the request is cancelled.
+	 * @param InDetectionRadius     Agent capsule radius (clearance requirement).
+	 * @param InDetectionHalfHeight Agent capsule half-height (clearance requirement).
+	 * @param InActor               Optional requesting actor; if it is a registered dynamic obstacle, its own cells are ignored.
+	 *
+	 * @return Request id for CancelSlicedPathRequest, or INDEX_NONE if the grid is not built.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D")
+	int32 RequestPathSliced(
+		const FVector& InStart,
+		const FVector& InDestination,
+		const FOnNavPathRequestComplete& OnComplete,
+		float InDetectionRadius = 34.f,
+		float InDetectionHalfHeight = 44.f,
+		AActor* InActor = nullptr
+	);
+
+	/**
+	 * Cancels a pending time-sliced path request. Its callback will not fire.
+	 *
+	 * @return true if the request was still pending.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D")
+	bool CancelSlicedPathRequest(int32 RequestId);
+
+	// --------------------------------------------------------------------
+	// Batch Pathfinding
+	// --------------------------------------------------------------------
+
+	/**
+	 * Runs many path queries at once (e.g. when a wave spawns) on all cores and returns when all are done.
+	 * Each worker searches with its own scratch state against the read-only grid; like async requests,
+	 * queries avoid registered dynamic obstacles but run no physics overlaps.
+	 *
+	 * @param InQueries   Start, goal and agent parameters per query.
+	 * @param OutResults  Status, expansion count and path per query, in the order of InQueries.
+	 *
+	 * @return Number of queries that found a path.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D")
+	int32 FindPathsBatch(const TArray<FNavBatchPathQuery>& InQueries, TArray<FNavBatchPathResult>& OutResults);
+
+	// --------------------------------------------------------------------
+	// Incremental Replanning
+	// --------------------------------------------------------------------
+
+	/**
+	 * Creates a persistent planner for an agent following a moving goal (e.g. chasing the player).
+	 * The planner keeps per-cell state for the whole grid, so create one per chasing agent, not per query.
+	 *
+	 * @param InDetectionRadius     Agent capsule radius (clearance requirement).
+	 * @param InDetectionHalfHeight Agent capsule half-height (clearance requirement).
+	 * @param InAgent               The agent itself: its own dynamic obstacle cells are not avoided. Optional.
+	 *
+	 * @return Id for UpdateIncrementalPlanner and DestroyIncrementalPlanner.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Replanning")
+	int32 CreateIncrementalPlanner(float InDetectionRadius = 34.f, float InDetectionHalfHeight = 44.f, AActor* InAgent = nullptr);
+
+	/**
+	 * Replans the path of a planner from the agent's current location to the current goal. The search
+	 * of the previous update is repaired rather than redone: the agent moving costs nothing, and a goal
+	 * moving a little or geometry and dynamic obstacles changing only touch the cells whose cost changed,
+	 * so calling it every frame is cheap. Always searches the grid; like async requests, it avoids
+	 * registered dynamic obstacles but runs no physics overlaps.
+	 *
+	 * @param PlannerId      Id returned by CreateIncrementalPlanner.
+	 * @param InStart        World-space agent location.
+	 * @param InDestination  World-space goal location (relocated to the nearest free cell if needed).
+	 * @param OutPath        Receives the world-space path (cell centers, start first).
+	 *
+	 * @return true if a path was found.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Replanning")
+	bool UpdateIncrementalPlanner(int32 PlannerId, const FVector& InStart, const FVector& InDestination, TArray<FVector>& OutPath);
+
+	/** Releases a planner created with CreateIncrementalPlanner. */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Replanning")
+	void DestroyIncrementalPlanner(int32 PlannerId);
+
+	// --------------------------------------------------------------------
+	// Path Cache
+	// --------------------------------------------------------------------
+
+	/**
+	 * Returns how many FindPath queries were answered from the path cache and how many had to search
+	 * since BeginPlay or the last ResetPathCacheStats. Queries that bypass the cache are not counted.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Cache")
+	void GetPathCacheStats(int64& OutHits, int64& OutMisses, int32& OutNumEntries) const;
+
+	/** Zeroes the path cache hit and miss counters. */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Cache")
+	void ResetPathCacheStats();
+
+	/** Drops every cached path. */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Cache")
+	void ClearPathCache();
+
+	// --------------------------------------------------------------------
+	// Flow Field
+	// --------------------------------------------------------------------
+
+	/**
+	 * Points the flow field at a goal shared by many agents (e.g. the player). Call it every frame:
+	 * the field is only rebuilt when the goal enters another cell or the agent size or bound changes.
+	 * Rebuilds run in Tick, FlowFieldExpansionsPerTick cells at a time, and always run to completion:
+	 * a goal that moves meanwhile is picked up by the next rebuild, so a fast goal makes the field lag
+	 * instead of never publishing it. Agents keep following the previous field until the new one is
+	 * complete. Only the baked grid is considered (no dynamic obstacles).
+	 *
+	 * @param InGoal                World-space goal; moved to the nearest cell the agent fits in.
+	 * @param InDetectionRadius     Agent capsule radius (clearance requirement).
+	 * @param InDetectionHalfHeight Agent capsule half-height (clearance requirement).
+	 * @param InMaxDistance         Path length beyond which cells are not reached, in world units; 0 for the whole volume.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|FlowField")
+	void SetFlowFieldGoal(const FVector& InGoal, float InDetectionRadius = 34.f, float InDetectionHalfHeight = 44.f, float InMaxDistance = 0.f);
+
+	/** Drops the flow field. */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|FlowField")
+	void ClearFlowField();
+
+	/** Returns true once a complete flow field can be sampled. */
+	UFUNCTION(BlueprintPure, Category = "SimpleOctaNavVolume3D|FlowField")
+	FORCEINLINE bool IsFlowFieldReady() const { return FlowField.IsComplete(); }
+
+	/**
+	 * Samples the flow field: the center of the next cell on the shortest path to its goal. O(1).
+	 *
+	 * @param InLocation       World-space agent location.
+	 * @param OutNextLocation  Receives the next cell center (the goal cell center once there).
+	 * @return false if no field is ready or the location was not reached by it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|FlowField")
+	bool GetFlowFieldNextLocation(const FVector& InLocation, FVector& OutNextLocation);
+
+	/**
+	 * Returns the path length from a location to the flow field goal in world units, or -1 if no field
+	 * is ready or the location was not reached by it.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|FlowField")
+	float GetFlowFieldDistance(const FVector& InLocation);
+
+	// --------------------------------------------------------------------
+	// Dynamic Geometry
+	// --------------------------------------------------------------------
+
+	/**
+	 * Marks a world-space box whose geometry changed (e.g. a destroyed wall).
+	 * Only the octree leaves and grid cells inside it are re-evaluated, on a worker thread;
+	 * the new data is swapped in on a later tick. Queries keep using the old data until then,
+	 * and async searches already running finish on the snapshot they started with.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Dynamic")
+	void MarkDirtyRegion(const FBox& WorldBox);
+
+	/**
+	 * Watches a primitive (moving platform, destructible piece): whenever its bounds change,
+	 * the old and new bounds are marked dirty. A destroyed primitive dirties its last bounds once.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Dynamic")
+	void RegisterDynamicPrimitive(UPrimitiveComponent* Primitive);
+
+	/** Stops watching a primitive. Its current footprint stays baked until the region is dirtied again. */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Dynamic")
+	void UnregisterDynamicPrimitive(UPrimitiveComponent* Primitive);
+
+	/**
+	 * Registers a moving actor (another agent, a rolling boulder) as a dynamic obstacle.
+	 * Every tick its collision bounds are rasterized into the occupancy layer, rewriting cells only
+	 * when it crosses a cell boundary. All path queries read that layer instead of running physics
+	 * overlap queries, and ignore the cells of the querying actor itself.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Dynamic")
+	void RegisterDynamicObstacle(AActor* Obstacle);
+
+	/** Removes a dynamic obstacle; its cells are freed on the next tick. */
+	UFUNCTION(BlueprintCallable, Category = "SimpleOctaNavVolume3D|Dynamic")
+	void UnregisterDynamicObstacle(AActor* Obstacle);
+
+#if WITH_EDITOR
+	// --------------------------------------------------------------------
+	// Baking
+	// --------------------------------------------------------------------
+
+	/**
+	 * Builds the grid, octree and (in sparse voxel mode) the leaf graph in the editor world
+	 * and stores them in BakedData. BeginPlay then loads them instead of querying physics.
+	 * Bake again after changing the level geometry or the volume settings.
+	 */
+	UFUNCTION(CallInEditor, Category = "SimpleOctaNavVolume3D|Baking")
+	void BakeNavigationData();
+#endif
+
 private:
+	// --------------------------------------------------------------------
+	// Navigation Data Setup
+	// --------------------------------------------------------------------
+
+	/** Builds the grid, octree, clearance field and (in sparse voxel mode) the leaf graph from the scene. */
+	void BuildNavigationData();
+
+	/**
+	 * Takes the grid, octree and leaf graph from BakedData.
+	 *
+	 * @return false if there is no baked data or it was baked with other settings.
+	 */
+	bool LoadBakedNavigationData();
+
+	/** Returns the current settings that baked data must have been made with. */
+	FNavBakeSettings GetBakeSettings();
+
+	// --------------------------------------------------------------------
+	// Pathfinding Internals
+	// --------------------------------------------------------------------
+
+	/**
+	 * Runs goal relocation and A* for FindPath.
+	 * On success the path (start first) is left in SearchContext.PathNodes: cell indices,
+	 * or sparse voxel graph nodes when UsesSparseVoxelGraph() is true.
+	 *
+	 * @param OutGoalLocation  Receives the destination, or the center of the cell it was relocated to.
+	 */
+	bool FindPathNodes(
+		const FVector& InStart,
+		const FVector& InDestination,
+		const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
+		UClass* InActorClassFilter,
+		AActor* InActor,
+		float InDetectionRadius,
+		float InDetectionHalfHeight,
+		FVector& OutGoalLocation);
+
+	/**
+	 * A* over the free octree leaves for FindPathNodes. Leaves are matched to the start
+	 * and goal locations; links whose shared face is narrower than the agent are skipped,
+	 * and so are leaves with a cell covered by a dynamic obstacle (other than InIgnoredObstacleSlot).
+	 */
+	bool FindSparseVoxelPathNodes(
+		const FVector& InStart,
+		const FVector& InGoalLocation,
+		float InDetectionRadius,
+		const FNavOverlapQuery* InOverlapQuery,
+		int32 InIgnoredObstacleSlot);
+
+	/**
+	 * Returns the hierarchical graph for a clearance requirement, building it on first use
+	 * (one graph per agent size class).
+	 */
+	FNavClusterGraph& FindOrBuildClusterGraph(int32 RequiredClearance);
+
+	/**
+	 * Returns the connected components of the free space for a clearance requirement, labelling
+	 * them on first use (one set of labels per agent size class).
+	 */
+	const FNavComponentLabels& FindOrBuildComponentLabels(int32 RequiredClearance);
+
+	/** Returns true if FindPath searches the sparse voxel graph instead of the grid. */
+	FORCEINLINE bool UsesSparseVoxelGraph() const
+	{
+		return SearchMode == ENavSearchMode::ENSM_SparseVoxel && SparseVoxelGraph.IsBuilt();
+	}
+
+	/** Returns true if queries are filtered by component labels (never with brick storage, see bUseComponentLabels). */
+	FORCEINLINE bool UsesComponentLabels() const
+	{
+		return bUseComponentLabels && !NavGrid->UsesBrickStorage();
+	}
+
+	/**
+	 * Appends the world-space points of SearchContext.PathNodes to OutPath:
+	 * cell centers on the grid, or start, portal centers and goal on the sparse voxel graph.
+	 */
+	template <typename AllocatorType>
+	void CopyPathPoints(const FVector& InStart, const FVector& InGoalLocation, TArray<FVector, AllocatorType>& OutPath) const
+	{
+		if (UsesSparseVoxelGraph())
+		{
+			SparseVoxelGraph.BuildPathPoints(SearchContext.PathNodes, InStart, InGoalLocation, OutPath);
+			return;
+		}
+
+		OutPath.Reserve(SearchContext.PathNodes.Num());
+		for (const int32 Node : SearchContext.PathNodes)
+		{
+			OutPath.Add(NavGrid->GetCellCenter(Node));
+		}
+	}
+
 	// --------------------------------------------------------------------
 	// Internal Drawing Helpers (debug grid)
 	// --------------------------------------------------------------------
@@ -225,68 +697,28 @@ private:
 	/**
 	 * Tests whether a capsule at a given world location is overlapping any blocking objects.
 	 *
-	 * @param InAgentRadius     Capsule radius.
-	 * @param AgentHalfHeight   Capsule half-height.
-	 * @param IgnoreActor       Actor to ignore during the query (optional).
-	 * @param WorldLocation     World-space center of the capsule.
-	 * @param InObjectTypes     Object types to test against.
-	 * @param InActorClassFilter Optional actor class filter (not actively used here).
+	 * @param InQuery         Prebuilt capsule, object types and ignored actor.
+	 * @param WorldLocation   World-space center of the capsule.
 	 *
 	 * @return true if any overlap is detected, false otherwise.
 	 */
-	bool IsActorOverlapping(
-		float InAgentRadius,
-		float AgentHalfHeight,
-		AActor* IgnoreActor,
-		const FVector& WorldLocation,
-		const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
-		UClass* InActorClassFilter) const;
-
-	// --------------------------------------------------------------------
-	// Nearest Free Node Search
-	// --------------------------------------------------------------------
-
-	/**
-	 * Performs a breadth-first search starting from InFromNode to find the nearest
-	 * grid node that is not blocked by static geometry (octree) and not overlapping
-	 * dynamic obstacles (via capsule overlap checks).
-	 *
-	 * @param InFromNode            Starting NavNode.
-	 * @param IgnoredActor          Actor to ignore for overlap tests (typically the agent).
-	 * @param InObjectTypes         Object types for overlap tests.
-	 * @param InActorClassFilter    Optional actor class filter.
-	 * @param InDetectionRadius     Capsule radius for overlap tests.
-	 * @param InDetectionHalfHeight Capsule half-height for overlap tests.
-	 *
-	 * @return Pointer to the nearest free NavNode, or nullptr if none found.
-	 */
-	NavNode* FindNearestFreeNode(
-		NavNode* InFromNode,
-		AActor* IgnoredActor,
-		const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
-		UClass* InActorClassFilter,
-		float InDetectionRadius,
-		float InDetectionHalfHeight
-	);
+	bool IsActorOverlapping(const FNavOverlapQuery& InQuery, const FVector& WorldLocation) const;
 
 	// --------------------------------------------------------------------
 	// Octree Construction / Query
 	// --------------------------------------------------------------------
 
 	/**
-	 * Recursively builds an octree node for the given box, splitting until either
-	 * the minimum cell size or maximum depth is reached.
+	 * Builds the octree for the given box, splitting until either the minimum cell size
+	 * or maximum depth is reached, tests every leaf for blockage (in parallel when
+	 * bParallelOctreeBuild is set) and merges uniform subtrees.
 	 *
-	 * @param InBox             World-space bounds of this node.
-	 * @param InDepth           Current recursion depth.
+	 * @param InBox             World-space bounds of the root node.
 	 * @param InObjectTypes     Object types for blockage tests.
 	 * @param InActorClassFilter Optional actor class filter (unused at the moment).
-	 *
-	 * @return Newly allocated FOctreeNode representing this region.
 	 */
-	FOctreeNode* BuildOctree(
+	void BuildOctree(
 		const FBox& InBox,
-		int32 InDepth,
 		const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
 		UClass* InActorClassFilter);
 
@@ -302,7 +734,7 @@ private:
 	bool IsBoxBlocked(
 		const FBox& InBox,
 		const TArray<TEnumAsByte<EObjectTypeQuery>>& InObjectTypes,
-		UClass* InActorClassFilter);
+		UClass* InActorClassFilter) const;
 
 	/**
 	 * Queries the octree to determine if a specific world point lies within a blocked node.
@@ -312,6 +744,84 @@ private:
 	 */
 	bool QueryPointBlocked(const FVector& WorldPoint) const;
 
+	/**
+	 * Rasterizes the blocked octree leaves into the grid's per-cell blocked bits.
+	 * The octree only changes through region rebuilds, so the hot path can test one bit
+	 * per cell instead of descending the tree. The octree itself is kept for coarse region queries.
+	 *
+	 * @param InOctree  Classified octree.
+	 * @param InGrid    Grid whose bits are rewritten.
+	 * @param MinCell   First cell of the inclusive range to rewrite.
+	 * @param MaxCell   Last cell of the inclusive range to rewrite.
+	 */
+	static void BakeOctreeOccupancy(const FNavOctree& InOctree, FNavGrid& InGrid, const FIntVector& MinCell, const FIntVector& MaxCell);
+
+	// --------------------------------------------------------------------
+	// Dynamic Geometry Internals
+	// --------------------------------------------------------------------
+
+	/** Marks the old and new bounds of registered primitives that moved (or were destroyed). */
+	void UpdateDynamicPrimitives();
+
+	/** Copies the navigation data and starts a worker task for the pending dirty regions. */
+	void LaunchRegionRebuild();
+
+	/** Worker side of a region rebuild: re-tests the dirty leaves and rewrites the copied grid. */
+	void RunRegionRebuild(FNavRegionRebuild& Rebuild) const;
+
+	/** Game-thread side of a finished region rebuild: swaps the new data in and patches the search graphs. */
+	void ApplyRegionRebuild();
+
+	/**
+	 * Re-rasterizes registered dynamic obstacles into the occupancy layer.
+	 * Copies the layer first if async searches still hold the current one.
+	 */
+	void UpdateDynamicObstacles();
+
+	/**
+	 * Drops cached paths crossing the cells of a geometry change, widened by the clearance cap
+	 * since clearance around the change is rewritten as well.
+	 */
+	void InvalidatePathCache(const FIntVector& MinCell, const FIntVector& MaxCell);
+
+	/**
+	 * Drops cached paths and queues planner repairs around cells a dynamic obstacle entered or left,
+	 * widened by the clearance cap since agents keep their clearance from obstacles as well.
+	 */
+	void InvalidateObstacleCells(const FIntVector& MinCell, const FIntVector& MaxCell);
+
+	/** Queues changed cells to every incremental planner; each repairs its search around them on its next update. */
+	void NotifyIncrementalPlanners(const FIntVector& MinCell, const FIntVector& MaxCell);
+
+	/**
+	 * Advances a pending flow field rebuild by FlowFieldExpansionsPerTick cells and publishes it once
+	 * complete, or starts one if the requested field or the grid changed since the last one started.
+	 */
+	void StepFlowField();
+
+	/** Returns the occupancy slot of a registered dynamic obstacle, or INDEX_NONE. */
+	int32 FindDynamicObstacleSlot(const AActor* Obstacle) const;
+
+	/** Returns the occupancy layer if any dynamic obstacle covers cells, or nullptr. */
+	FORCEINLINE const FNavOccupancyLayer* GetActiveOccupancy() const
+	{
+		return DynamicOccupancy->HasOccupiedCells() ? &DynamicOccupancy.Get() : nullptr;
+	}
+
+
+	// --------------------------------------------------------------------
+	// Diagnostics
+	// --------------------------------------------------------------------
+
+	/** Logs node expansion and heap operation counts of the last A* query (editor builds only). */
+	void LogSearchStats() const;
+
+	/** Pops finished async results and runs their callbacks, up to MaxAsyncResultsPerFrame. */
+	void DeliverAsyncPathResults();
+
+	/** Runs this tick's share of the time-sliced searches and the callbacks of those that finished. */
+	void UpdateSlicedPathRequests();
+
 private:
 	// --------------------------------------------------------------------
 	// Components
@@ -352,6 +862,158 @@ private:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true", ClampMin = 0, ClampMax = 2))
 	int32 MinSharedNeighborAxes = 0;
 
+	/**
+	 * Precompute a per-cell distance-to-nearest-blocked-cell field after the octree is baked.
+	 * Agent size is then checked with one comparison per cell instead of a capsule overlap query.
+	 * When disabled, every improved neighbour falls back to a physics overlap query.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true"))
+	bool bUseClearanceField = true;
+
+	/**
+	 * Largest clearance stored in the field, in cells. Agents needing more are treated as needing this much.
+	 * Higher values cost more build time (linear in this value).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true", ClampMin = 1, ClampMax = 255, EditCondition = "bUseClearanceField"))
+	int32 MaxClearanceCells = 4;
+
+	/**
+	 * Store grid cells in 8x8x8 bricks: bricks that are entirely free, entirely blocked or at a uniform
+	 * clearance cost a table entry instead of per-cell storage. Use for very large volumes that are mostly
+	 * empty (or solid); cell lookups are slightly slower than with the default flat storage. Search state
+	 * is then paged by brick as well, so searches only pay for the cells they visit.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true"))
+	bool bUseBrickStorage = false;
+
+	/**
+	 * Additionally run capsule overlap queries against the physics scene while searching,
+	 * to avoid dynamic actors that are not part of the baked occupancy.
+	 * Registering movers with RegisterDynamicObstacle is much cheaper: it costs one rasterization
+	 * per obstacle per tick instead of one physics query per expanded cell of every query.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true"))
+	bool bUseDynamicOverlapChecks = false;
+
+	/**
+	 * Graph searched by FindPath. Sparse Voxel Octree searches the free octree leaves, so large open
+	 * regions cost a handful of nodes instead of one per cell; paths run through the shared face
+	 * centers between leaves. The grid is still built (goal relocation, async requests).
+	 * Grid (Jump Point Search) returns grid paths of the same cost as Grid with far fewer expansions,
+	 * for async requests too; it needs MinSharedNeighborAxes = 0.
+	 * Hierarchical (HPA*) keeps long queries cheap; async requests use Grid.
+	 * Grid (Any-Angle Theta*) connects waypoints in line of sight, for short paths with few points.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true"))
+	ENavSearchMode SearchMode = ENavSearchMode::ENSM_Grid;
+
+	/**
+	 * Side length, in cells, of the clusters used by the hierarchical search mode.
+	 * Larger clusters mean fewer abstract nodes but more work per query inside the start and goal clusters.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true", ClampMin = 2, ClampMax = 64, EditCondition = "SearchMode == ENavSearchMode::ENSM_Hierarchical"))
+	int32 HierarchicalClusterSize = 8;
+
+	/**
+	 * Post-process grid paths (Grid, Jump Point Search, Hierarchical, async requests): drop collinear
+	 * points, then skip every waypoint the agent can reach in a straight line (clearance respected).
+	 * Not applied in Sparse Voxel Octree mode, whose paths already run through leaf faces.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true"))
+	bool bSmoothPaths = false;
+
+	/**
+	 * Label the connected components of the free space (per agent size class) and reject queries whose
+	 * goal lies in another component than the start without searching. Goals relocated to a free cell
+	 * only consider cells in the start's component. Costs one int32 per cell and size class, so it is
+	 * ignored when the grid uses brick storage (large volumes). Labels of the smallest size class are
+	 * baked with the navigation data; the others are built on first query. Not used in Sparse Voxel Octree mode.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true"))
+	bool bUseComponentLabels = true;
+
+	/**
+	 * How far, in cells on every axis, a goal the agent does not fit in may move to the nearest free cell.
+	 * Larger values find goals deep inside big blockers but scan more cells before giving up.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Pathfinding", meta = (AllowPrivateAccess = "true", ClampMin = 0, ClampMax = 256))
+	int32 GoalSearchRadius = FNavPathQuery::DefaultGoalSearchRadius;
+
+	// --------------------------------------------------------------------
+	// Path Cache Settings
+	// --------------------------------------------------------------------
+
+	/**
+	 * Keep recent FindPath results and return them for repeated queries with the same start cell, goal cell,
+	 * agent size class and object types. A cached path is dropped once geometry (MarkDirtyRegion, region rebuilds)
+	 * or a dynamic obstacle changes in a region it crosses; changes elsewhere keep it, even if they open a shorter route.
+	 * Physics overlap queries (bUseDynamicOverlapChecks, no clearance field) and Sparse Voxel Octree mode are not cached.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Cache", meta = (AllowPrivateAccess = "true"))
+	bool bUsePathCache = false;
+
+	/** Maximum number of cached paths; the least recently used one is replaced when full. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Cache", meta = (AllowPrivateAccess = "true", ClampMin = 1, EditCondition = "bUsePathCache"))
+	int32 PathCacheCapacity = 256;
+
+	/**
+	 * Side length, in cells, of the regions cached paths are invalidated by.
+	 * Smaller regions drop fewer paths per change but cost more bookkeeping per cached path.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Cache", meta = (AllowPrivateAccess = "true", ClampMin = 1, ClampMax = 256, EditCondition = "bUsePathCache"))
+	int32 PathCacheRegionSize = 16;
+
+	// --------------------------------------------------------------------
+	// Flow Field Settings
+	// --------------------------------------------------------------------
+
+	/**
+	 * Cells settled per tick while a flow field rebuilds; the previous field stays in use meanwhile.
+	 * 0 builds the whole field in one tick: a full-volume Dijkstra on the game thread every time the
+	 * goal enters another cell, which hitches on large volumes.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|FlowField", meta = (AllowPrivateAccess = "true", ClampMin = 0))
+	int32 FlowFieldExpansionsPerTick = 16384;
+
+	// --------------------------------------------------------------------
+	// Async Pathfinding Settings
+	// --------------------------------------------------------------------
+
+	/** Maximum number of async path searches running on worker threads at the same time. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Async", meta = (AllowPrivateAccess = "true", ClampMin = 1))
+	int32 MaxConcurrentAsyncSearches = 2;
+
+	/** Maximum number of async path callbacks run per frame; further results wait for the next frame. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Async", meta = (AllowPrivateAccess = "true", ClampMin = 1))
+	int32 MaxAsyncResultsPerFrame = 8;
+
+	// --------------------------------------------------------------------
+	// Time-Sliced Pathfinding Settings
+	// --------------------------------------------------------------------
+
+	/** Game-thread time, in milliseconds, all time-sliced searches may spend per tick together. 0 for no time limit. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Sliced", meta = (AllowPrivateAccess = "true", ClampMin = 0.0))
+	float SlicedSearchBudgetMs = 1.0f;
+
+	/** Nodes all time-sliced searches may expand per tick together. 0 for no expansion limit. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Sliced", meta = (AllowPrivateAccess = "true", ClampMin = 0))
+	int32 SlicedSearchExpansionsPerTick = 0;
+
+	/**
+	 * Maximum number of time-sliced searches in progress at once; later requests wait their turn.
+	 * Each one in progress holds its own search state (sized to the grid).
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Sliced", meta = (AllowPrivateAccess = "true", ClampMin = 1))
+	int32 MaxConcurrentSlicedSearches = 8;
+
+	// --------------------------------------------------------------------
+	// Batch Pathfinding Settings
+	// --------------------------------------------------------------------
+
+	/** Spread the queries of FindPathsBatch over worker threads. Disable to run them on the game thread. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "SimpleOctaNavVolume3D|Batch", meta = (AllowPrivateAccess = "true"))
+	bool bParallelBatchPathfinding = true;
+
 	// --------------------------------------------------------------------
 	// Drawing Settings (debug grid)
 	// --------------------------------------------------------------------
@@ -375,17 +1037,103 @@ private:
 	UPROPERTY(EditAnywhere, Category = "SimpleOctaNavVolume3D|Octree", meta = (ClampMin = 1.0))
 	float OctreeMinCellSize = 100.0f;
 
-	/** Root node of the navigation octree (nullptr if not built). */
-	FOctreeNode* OctreeRoot = nullptr;
+	/** Navigation octree (empty if not built). */
+	FNavOctree Octree;
 
 	/** Maximum recursion depth allowed for the octree (1..10). */
 	UPROPERTY(EditAnywhere, Category = "SimpleOctaNavVolume3D|Octree", meta = (ClampMin = 1, ClampMax = 10))
 	int32 OctreeMaxDepth = 5;
 
+	/**
+	 * Run the per-leaf overlap tests of the octree build on all cores.
+	 * The result is identical to a serial build; disable to compare timings ("stat SimpleNav3D").
+	 */
+	UPROPERTY(EditAnywhere, Category = "SimpleOctaNavVolume3D|Octree")
+	bool bParallelOctreeBuild = true;
+
+	/**
+	 * Navigation data baked with BakeNavigationData. When it matches the volume settings, BeginPlay
+	 * loads it instead of building the octree from physics queries; otherwise it builds at runtime.
+	 */
+	UPROPERTY(EditAnywhere, Category = "SimpleOctaNavVolume3D|Baking", meta = (AllowPrivateAccess = "true"))
+	TObjectPtr<UNavBakedData> BakedData = nullptr;
+
 	// --------------------------------------------------------------------
 	// Runtime Data
 	// --------------------------------------------------------------------
 
-	/** Contiguous array of NavNodes representing the 3D grid, used by A*. */
-	NavNode* NavNodes = nullptr;
+	/**
+	 * Compact grid storage (walkability bits, clearance, implicit neighbours) used by A*.
+	 * Shared with async path workers as a read-only snapshot: only mutate it in place
+	 * while no async search can be running (i.e. during BeginPlay). Region rebuilds
+	 * replace it with an updated copy instead.
+	 */
+	TSharedRef<FNavGrid, ESPMode::ThreadSafe> NavGrid = MakeShared<FNavGrid, ESPMode::ThreadSafe>();
+
+	/** Free-leaf adjacency graph of the octree (built only in sparse voxel search mode). */
+	FNavSparseVoxelGraph SparseVoxelGraph;
+
+	/** Hierarchical search graphs by required clearance (built on demand in hierarchical search mode). */
+	TMap<int32, FNavClusterGraph> ClusterGraphs;
+
+	/** Connected components of the free space by required clearance (when bUseComponentLabels is set). */
+	TMap<int32, FNavComponentLabels> ComponentLabels;
+
+	/** Reusable A* scratch state (g-scores, parents, open list) indexed by linear cell or graph node index. */
+	FNavSearchContext SearchContext;
+
+	/** Scratch state of the search from the goal in bidirectional search mode. */
+	FNavSearchContext BackwardSearchContext;
+
+	/** Recent FindPath results (initialized in BeginPlay when bUsePathCache is set). */
+	FNavPathCache PathCache;
+
+	/** Complete flow field sampled by agents, and the one being built for a new goal or grid. */
+	FNavFlowField FlowField;
+	FNavFlowField PendingFlowField;
+	bool bFlowFieldPending = false;
+
+	/** Field last requested by SetFlowFieldGoal (INDEX_NONE goal for none); built once no rebuild is pending. */
+	int32 FlowFieldGoalCell = INDEX_NONE;
+	int32 FlowFieldRequiredClearance = 0;
+	float FlowFieldMaxCost = 0.0f;
+
+	/** Set when the grid changed after the current (published or pending) field was started. */
+	bool bFlowFieldGridChanged = false;
+
+	/** Queue and workers for RequestPathAsync. */
+	FNavAsyncPathService AsyncPathService;
+
+	/** Game-thread callbacks of outstanding async requests, by request id. */
+	TMap<int32, FOnNavPathRequestComplete> AsyncPathCallbacks;
+
+	/** Resumable searches for RequestPathSliced, and their callbacks by request id. */
+	FNavSlicedPathService SlicedPathService;
+	TMap<int32, FOnNavPathRequestComplete> SlicedPathCallbacks;
+
+	/** Per-worker search contexts for FindPathsBatch. */
+	FNavBatchPathService BatchPathService;
+
+	/** Planners created with CreateIncrementalPlanner, by id. */
+	TMap<int32, FNavIncrementalPlannerEntry> IncrementalPlanners;
+	int32 NextIncrementalPlannerId = 1;
+
+	/** Dirty boxes waiting for the next region rebuild. */
+	TArray<FBox> PendingDirtyRegions;
+
+	/** Primitives whose movement dirties the volume. */
+	TArray<FNavDynamicPrimitive> DynamicPrimitives;
+
+	/** Region rebuild in flight (at most one), and the worker task filling it. */
+	TSharedPtr<FNavRegionRebuild, ESPMode::ThreadSafe> RegionRebuild;
+	UE::Tasks::FTask RegionRebuildTask;
+
+	/**
+	 * Cells covered by registered dynamic obstacles. Shared with async path workers like NavGrid:
+	 * UpdateDynamicObstacles writes a copy while a worker still reads the current one.
+	 */
+	TSharedRef<FNavOccupancyLayer, ESPMode::ThreadSafe> DynamicOccupancy = MakeShared<FNavOccupancyLayer, ESPMode::ThreadSafe>();
+
+	/** Actors rasterized into DynamicOccupancy. */
+	TArray<FNavDynamicObstacle> DynamicObstacles;
 };